@@ -320,6 +320,101 @@ int signature_invariant_test(void){
 }
 #endif
 
+#if defined(PAR_HASH_WAYS)
+#include "matrix_layout.h"
+/* checks the batched syndrome computation against the one vector at a time
+ * one, for all batch sizes up to PAR_HASH_WAYS */
+int fp_mat_by_fp_matrix_batch_test(void){
+    uint8_t seed[SEED_LENGTH_BYTES];
+    randombytes(seed,SEED_LENGTH_BYTES);
+    CSPRNG_STATE_T csprng_state;
+    csprng_initialize(&csprng_state, seed, SEED_LENGTH_BYTES, 0);
+
+    FP_ELEM V_tr[K][N-K];
+    csprng_fp_mat(V_tr,&csprng_state);
+    MATRIX_ALIGNAS V_TR_ELEM V_tr_layout[K][V_TR_COLS] = {{0}};
+    for(int i = 0; i < K; i++){
+      for (int j = 0; j < N-K; j++){
+         V_tr_layout[i][j] = V_tr[i][j];
+      }
+    }
+
+    FP_ELEM e[PAR_HASH_WAYS][N];
+    FP_ELEM res_batch[PAR_HASH_WAYS][N-K];
+    FP_ELEM *e_ptrs[PAR_HASH_WAYS], *res_ptrs[PAR_HASH_WAYS];
+    for(int r = 0; r < PAR_HASH_WAYS; r++){
+        csprng_fp_vec(e[r], &csprng_state);
+        e_ptrs[r] = e[r];
+        res_ptrs[r] = res_batch[r];
+    }
+    /* the largest coefficients exercise the lazy reduction bounds */
+    for(int i = 0; i < N; i++){
+        e[0][i] = P-1;
+    }
+
+    for(int batch = 1; batch <= PAR_HASH_WAYS; batch++){
+        fp_mat_by_fp_matrix_batch(batch, res_ptrs, e_ptrs, V_tr_layout);
+        for(int r = 0; r < batch; r++){
+            FP_ELEM res[N-K];
+            fp_vec_by_fp_matrix(res, e[r], V_tr_layout);
+            fp_dz_norm_synd(res);
+            fp_dz_norm_synd(res_batch[r]);
+            if(memcmp(res, res_batch[r], sizeof(res)) != 0){
+                fprintf(stderr,"batch syndrome mismatch: batch %d, vector %d\n",
+                        batch, r);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/* checks the fused round kernels against the composable path they replace,
+ * with e_bar_prime and u_prime also taking the redundant zero, and with u
+ * computed in place of u_prime as in the low memory sign */
+int restr_diff_by_fp_vec_pointwise_test(void){
+    uint8_t seed[SEED_LENGTH_BYTES];
+    randombytes(seed,SEED_LENGTH_BYTES);
+    CSPRNG_STATE_T csprng_state;
+    csprng_initialize(&csprng_state, seed, SEED_LENGTH_BYTES, 0);
+
+    uint16_t rnd[3][N];
+    csprng_randombytes((uint8_t *)rnd, sizeof(rnd), &csprng_state);
+    FZ_ELEM e_bar[N], e_bar_prime[N];
+    FP_ELEM u_prime[N];
+    for(int i = 0; i < N; i++){
+        e_bar[i] = rnd[0][i] % Z;
+        e_bar_prime[i] = rnd[1][i] % (Z+1);
+        u_prime[i] = rnd[2][i] % (P == 127 ? P+1 : P);
+    }
+
+    FZ_ELEM v_bar_ref[N], v_bar[N];
+    FP_ELEM v[N], u_ref[N], u[N];
+    fz_vec_sub_n(v_bar_ref, e_bar, e_bar_prime);
+    convert_restr_vec_to_fp(v, v_bar_ref);
+    fp_vec_by_fp_vec_pointwise(u_ref, v, u_prime);
+
+    restr_diff_by_fp_vec_pointwise(u, v_bar, e_bar, e_bar_prime, u_prime);
+    if(memcmp(v_bar, v_bar_ref, sizeof(v_bar)) != 0 ||
+       memcmp(u, u_ref, sizeof(u)) != 0){
+        fprintf(stderr,"fused round kernel mismatch\n");
+        return 0;
+    }
+    restr_by_fp_vec_pointwise(u, v_bar_ref, u_prime);
+    if(memcmp(u, u_ref, sizeof(u)) != 0){
+        fprintf(stderr,"restricted pointwise product mismatch\n");
+        return 0;
+    }
+    memcpy(u, u_prime, sizeof(u));
+    restr_diff_by_fp_vec_pointwise(u, v_bar, e_bar, e_bar_prime, u);
+    if(memcmp(u, u_ref, sizeof(u)) != 0){
+        fprintf(stderr,"in place fused round kernel mismatch\n");
+        return 0;
+    }
+    return 1;
+}
+#endif
+
 int fp_arith_testing(void){
   /*Testing fast constant time reduction against regular one
    * Barrett's method for q = 509
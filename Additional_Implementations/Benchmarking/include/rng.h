@@ -1,7 +1,8 @@
 #include "csprng_hash.h"
 
-/* global csprng state employed to have deterministic randombytes for testing */
-CSPRNG_STATE_T platform_csprng_state;
+/* global csprng state employed to have deterministic randombytes for testing,
+ * one per thread so that concurrent signers draw independent randomness */
+_Thread_local CSPRNG_STATE_T platform_csprng_state;
 /* extracts xlen bytes from the global CSPRNG */
 void randombytes(unsigned char * x,
                  unsigned long long xlen) {
@@ -32,8 +32,17 @@
 #pragma once
 #include <math.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
-#if (defined HIGH_PERFORMANCE_X86_64)
+#if (defined HIGH_PERFORMANCE_X86_64) || (defined __x86_64__)
 static inline
 uint64_t x86_64_rtdsc(void) {
   unsigned long long result;
@@ -48,6 +57,207 @@ uint64_t x86_64_rtdsc(void) {
 }
 #endif
 
+/* Timing backends, selected at runtime by timing_init: core cycles and
+ * further hardware events counted by perf_event_open on Linux, reference
+ * cycles counted by rdtscp on x86-64, nanoseconds from clock_gettime
+ * elsewhere. The environment variable CROSS_TIMING set to perf, rdtsc or
+ * clock forces a backend, the first available one in this order is taken
+ * otherwise. The state is per thread: threads other than the one calling
+ * timing_init employ the default backend until they call it */
+typedef enum {
+    TIMING_PERF_EVENT,
+    TIMING_RDTSC,
+    TIMING_CLOCK_GETTIME
+} timing_backend_t;
+
+#if (defined HIGH_PERFORMANCE_X86_64) || (defined __x86_64__)
+#define TIMING_DEFAULT_BACKEND TIMING_RDTSC
+#else
+#define TIMING_DEFAULT_BACKEND TIMING_CLOCK_GETTIME
+#endif
+
+/* hardware events counted by the perf_event backend, in group order */
+typedef enum {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_L1D_MISSES,
+    PERF_LLC_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_NUM_EVENTS
+} perf_event_id_t;
+
+typedef struct {
+    uint64_t count[PERF_NUM_EVENTS];
+} perf_counts_t;
+
+typedef struct {
+    timing_backend_t backend;
+    /* file descriptors of the events, -1 if not available, the cycles one
+     * leading the group */
+    int fd[PERF_NUM_EVENTS];
+} timing_state_t;
+
+static inline
+timing_state_t *timing_state(void){
+    static _Thread_local timing_state_t state = { .backend = TIMING_DEFAULT_BACKEND };
+    return &state;
+}
+
+#if defined(__linux__)
+static inline
+int perf_event_open_counter(uint32_t type, uint64_t config, int group_fd){
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = (group_fd == -1);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+static inline
+int timing_perf_event_init(timing_state_t *state){
+    static const uint32_t types[PERF_NUM_EVENTS] = {
+        PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE,
+        PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE
+    };
+    static const uint64_t configs[PERF_NUM_EVENTS] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+        PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                 (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+        PERF_COUNT_HW_BRANCH_MISSES
+    };
+    state->fd[PERF_CYCLES] = perf_event_open_counter(types[PERF_CYCLES],
+                                                     configs[PERF_CYCLES], -1);
+    if(state->fd[PERF_CYCLES] < 0){
+        return 0;
+    }
+    /* the other events are optional, e.g., virtual machines may lack them */
+    for(int e = PERF_CYCLES+1; e < PERF_NUM_EVENTS; e++){
+        state->fd[e] = perf_event_open_counter(types[e], configs[e],
+                                               state->fd[PERF_CYCLES]);
+    }
+    ioctl(state->fd[PERF_CYCLES], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(state->fd[PERF_CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return 1;
+}
+#endif
+
+static inline
+timing_backend_t timing_init(void){
+    timing_state_t *state = timing_state();
+    for(int e = 0; e < PERF_NUM_EVENTS; e++){
+        state->fd[e] = -1;
+    }
+    const char *forced = getenv("CROSS_TIMING");
+    state->backend = TIMING_DEFAULT_BACKEND;
+    if(forced != NULL && strcmp(forced,"clock") == 0){
+        state->backend = TIMING_CLOCK_GETTIME;
+        return state->backend;
+    }
+    if(forced != NULL && strcmp(forced,"rdtsc") == 0){
+        return state->backend;
+    }
+#if defined(__linux__)
+    if(timing_perf_event_init(state)){
+        state->backend = TIMING_PERF_EVENT;
+    }
+#endif
+    return state->backend;
+}
+
+static inline
+void timing_release(void){
+    timing_state_t *state = timing_state();
+#if defined(__linux__)
+    if(state->backend == TIMING_PERF_EVENT){
+        for(int e = PERF_NUM_EVENTS-1; e >= 0; e--){
+            if(state->fd[e] >= 0){
+                close(state->fd[e]);
+                state->fd[e] = -1;
+            }
+        }
+    }
+#endif
+    state->backend = TIMING_DEFAULT_BACKEND;
+}
+
+static inline
+const char *timing_backend_name(void){
+    switch(timing_state()->backend){
+        case TIMING_PERF_EVENT: return "perf_event core cycles";
+        case TIMING_RDTSC: return "rdtscp reference cycles";
+        default: return "clock_gettime nanoseconds";
+    }
+}
+
+static inline
+uint64_t clock_gettime_ns(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec*1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* current value of all the events; with the rdtsc and clock_gettime
+ * backends, only the cycles are filled, with the timestamp */
+static inline
+void perf_counts_read(perf_counts_t *counts){
+    timing_state_t *state = timing_state();
+    memset(counts, 0, sizeof(perf_counts_t));
+#if defined(__linux__)
+    if(state->backend == TIMING_PERF_EVENT){
+        /* group read: number of events, then their values in opening order */
+        uint64_t values[1+PERF_NUM_EVENTS];
+        if(read(state->fd[PERF_CYCLES], values, sizeof(values)) > 0){
+            int v = 1;
+            for(int e = 0; e < PERF_NUM_EVENTS; e++){
+                if(state->fd[e] >= 0 && v <= (int)values[0]){
+                    counts->count[e] = values[v++];
+                }
+            }
+        }
+        return;
+    }
+#endif
+#if (defined HIGH_PERFORMANCE_X86_64) || (defined __x86_64__)
+    if(state->backend == TIMING_RDTSC){
+        counts->count[PERF_CYCLES] = x86_64_rtdsc();
+        return;
+    }
+#endif
+    counts->count[PERF_CYCLES] = clock_gettime_ns();
+}
+
+/* timestamp of the selected backend, in cycles, nanoseconds for the
+ * clock_gettime one */
+static inline
+uint64_t timing_now(void){
+#if (defined HIGH_PERFORMANCE_X86_64) || (defined __x86_64__)
+    if(timing_state()->backend == TIMING_RDTSC){
+        return x86_64_rtdsc();
+    }
+#endif
+    perf_counts_t counts;
+    perf_counts_read(&counts);
+    return counts.count[PERF_CYCLES];
+}
+
+/* events counted from begin to end, accumulated in total */
+static inline
+void perf_counts_accumulate(perf_counts_t *total,
+                            const perf_counts_t *begin,
+                            const perf_counts_t *end){
+    for(int e = 0; e < PERF_NUM_EVENTS; e++){
+        total->count[e] += end->count[e] - begin->count[e];
+    }
+}
+
 typedef struct {
      long double mean;
      long double M2;
@@ -72,6 +282,21 @@ void welford_update(welford_t* state, long double sample){
     state->M2 += delta * delta2;
 }
 
+/* merges the samples accumulated in other into state */
+static inline
+void welford_combine(welford_t* state, const welford_t other){
+    long count = state->count + other.count;
+    if(count == 0){
+        return;
+    }
+    long double delta = other.mean - state->mean;
+    state->mean += delta * (long double)other.count / (long double)count;
+    state->M2 += other.M2 + delta * delta *
+                 (long double)state->count * (long double)other.count /
+                 (long double)count;
+    state->count = count;
+}
+
 static inline
 double welch_t_statistic(const welford_t state1,
                          const welford_t state2){
@@ -108,3 +333,78 @@ static inline
 long double welford_mean(const welford_t state){
      return state.mean;
 }
+
+/* HdrHistogram style log-linear histogram of integer samples (cycles):
+ * samples below HDR_SUB_BUCKETS are counted exactly, larger ones in the
+ * HDR_SUB_BUCKETS/2 linear sub-buckets of their power of two, bounding the
+ * relative error of the reported percentiles to 2/HDR_SUB_BUCKETS */
+#define HDR_SUB_BUCKET_BITS 8
+#define HDR_SUB_BUCKETS (1 << HDR_SUB_BUCKET_BITS)
+/* samples up to 2^40 cycles */
+#define HDR_MAGNITUDES (40-HDR_SUB_BUCKET_BITS+1)
+
+typedef struct {
+     uint64_t counts[HDR_MAGNITUDES][HDR_SUB_BUCKETS];
+     uint64_t count;
+     uint64_t max;
+} hdr_histogram_t;
+
+static inline
+void hdr_init(hdr_histogram_t* h){
+    for(int m = 0; m < HDR_MAGNITUDES; m++){
+        for(int s = 0; s < HDR_SUB_BUCKETS; s++){
+            h->counts[m][s] = 0;
+        }
+    }
+    h->count = 0;
+    h->max = 0;
+}
+
+static inline
+void hdr_record(hdr_histogram_t* h, uint64_t sample){
+    int magnitude = 0;
+    if(sample >= HDR_SUB_BUCKETS){
+        magnitude = 64-__builtin_clzll(sample)-HDR_SUB_BUCKET_BITS;
+        if(magnitude >= HDR_MAGNITUDES){
+            magnitude = HDR_MAGNITUDES-1;
+            sample = ((uint64_t)HDR_SUB_BUCKETS << magnitude)-1;
+        }
+    }
+    h->counts[magnitude][sample >> magnitude]++;
+    h->count++;
+    if(sample > h->max){
+        h->max = sample;
+    }
+}
+
+/* smallest bucket upper bound having at least a fraction p of the samples
+ * at or below it, capped to the largest sample */
+static inline
+uint64_t hdr_percentile(const hdr_histogram_t* h, double p){
+    uint64_t rank = (uint64_t)ceill(p*(long double)h->count);
+    if(rank == 0){
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for(int m = 0; m < HDR_MAGNITUDES; m++){
+        for(int s = (m == 0) ? 0 : HDR_SUB_BUCKETS/2; s < HDR_SUB_BUCKETS; s++){
+            seen += h->counts[m][s];
+            if(seen >= rank){
+                uint64_t upper = (((uint64_t)s+1) << m)-1;
+                return upper < h->max ? upper : h->max;
+            }
+        }
+    }
+    return h->max;
+}
+
+/* p50, p90, p99, p99.9 and max, in thousands of cycles */
+static inline
+void hdr_print(const hdr_histogram_t* h){
+     printf("%.2f,%.2f,%.2f,%.2f,%.2f",
+              hdr_percentile(h,0.5)/1000.0,
+              hdr_percentile(h,0.9)/1000.0,
+              hdr_percentile(h,0.99)/1000.0,
+              hdr_percentile(h,0.999)/1000.0,
+              h->max/1000.0);
+}
@@ -28,18 +28,23 @@
  * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *
  **/
+#include <inttypes.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
-#define HIGH_PERFORMANCE_X86_64
 #include "timing_and_stat.h"
+#include "alloc_count.h"
 #include "CROSS.h"
+#include "api.h"
 #include "csprng_hash.h"
 #include "rng.h"
 
 
 #define NUM_TESTS 10000
+/* signatures per CROSS_sign_batch/CROSS_verify_batch call in the batch timings */
+#define BATCH_SIZE 8
 
 void microbench(){
     welford_t timer;
@@ -47,8 +52,8 @@ void microbench(){
 
     uint64_t cycles;
     for(int i = 0; i <NUM_TESTS; i++) {
-        cycles = x86_64_rtdsc();
-        welford_update(&timer,(x86_64_rtdsc()-cycles)/1000.0);
+        cycles = timing_now();
+        welford_update(&timer,(timing_now()-cycles)/1000.0);
     }
     fprintf(stderr,"microbench kCycles (avg,stddev):");
     welford_print(timer);
@@ -67,7 +72,62 @@ void info(){
 
 }
 
-void CROSS_sign_verify_speed(int print_tex){
+/* output formats of CROSS_sign_verify_speed: human readable text, LaTeX
+ * table rows (-T), one JSON object (-J) or CSV rows with header (-C) */
+typedef enum {
+    OUTPUT_TEXT,
+    OUTPUT_TEX,
+    OUTPUT_JSON,
+    OUTPUT_CSV
+} output_format_t;
+
+static
+const char *parameter_set_name(){
+#if defined(CATEGORY_1)
+#define CATEGORY_NAME "cat_1"
+#elif defined(CATEGORY_3)
+#define CATEGORY_NAME "cat_3"
+#elif defined(CATEGORY_5)
+#define CATEGORY_NAME "cat_5"
+#endif
+#if defined(RSDP)
+#define VARIANT_NAME "RSDP"
+#elif defined(RSDPG)
+#define VARIANT_NAME "RSDPG"
+#endif
+#if defined(SIG_SIZE)
+#define TARGET_NAME "SIG_SIZE"
+#elif defined(BALANCED)
+#define TARGET_NAME "BALANCED"
+#elif defined(SPEED)
+#define TARGET_NAME "SPEED"
+#endif
+    return CATEGORY_NAME "_" VARIANT_NAME "_" TARGET_NAME;
+}
+
+static
+void operation_print_json(const char *operation, const welford_t timer,
+                          const hdr_histogram_t *hist){
+    printf("\"%s\": {\"mean\": %.2Lf, \"stddev\": %.2Lf, "
+           "\"p50\": %.2f, \"p90\": %.2f, \"p99\": %.2f, "
+           "\"p999\": %.2f, \"max\": %.2f}",
+           operation, welford_mean(timer), welford_stddev(timer),
+           hdr_percentile(hist,0.5)/1000.0, hdr_percentile(hist,0.9)/1000.0,
+           hdr_percentile(hist,0.99)/1000.0, hdr_percentile(hist,0.999)/1000.0,
+           hist->max/1000.0);
+}
+
+static
+void operation_print_csv(const char *operation, const welford_t timer,
+                         const hdr_histogram_t *hist){
+    printf("%s,%s,", parameter_set_name(), operation);
+    welford_print(timer);
+    printf(",");
+    hdr_print(hist);
+    printf("\n");
+}
+
+void CROSS_sign_verify_speed(output_format_t format){
     fprintf(stderr,"Computing number of clock cycles as the average of %d runs\n", NUM_TESTS);
     uint64_t cycles;
     pk_t pk;
@@ -75,29 +135,112 @@ void CROSS_sign_verify_speed(int print_tex){
     CROSS_sig_t signature;
     char message[32] = "Signme!!Signme!!Signme!!Signme!";
 
-    welford_t timer_KG,timer_Sig,timer_Ver;
+    welford_t timer_KG,timer_Sig,timer_Sig_exp,timer_Sig_batch,timer_Ver,timer_Ver_exp,timer_Ver_batch;
+    /* latency distributions, in cycles */
+    static hdr_histogram_t hist_KG,hist_Sig,hist_Ver;
+    hdr_init(&hist_KG);
+    hdr_init(&hist_Sig);
+    hdr_init(&hist_Ver);
     welford_init(&timer_KG);
     welford_init(&timer_Sig);
+    welford_init(&timer_Sig_exp);
+    welford_init(&timer_Sig_batch);
     welford_init(&timer_Ver);
+    welford_init(&timer_Ver_exp);
+    welford_init(&timer_Ver_batch);
 
     for(int i = 0; i <NUM_TESTS; i++) {
-        cycles = x86_64_rtdsc();
+        cycles = timing_now();
         CROSS_keygen(&sk,&pk);
-        welford_update(&timer_KG,(x86_64_rtdsc()-cycles)/1000.0);
+        cycles = timing_now()-cycles;
+        welford_update(&timer_KG,cycles/1000.0);
+        hdr_record(&hist_KG,cycles);
     }
+    alloc_calls = 0;
     for(int i = 0; i <NUM_TESTS; i++) {
-        cycles = x86_64_rtdsc();
+        cycles = timing_now();
         CROSS_sign(&sk,message,8,&signature);
-        welford_update(&timer_Sig,(x86_64_rtdsc()-cycles)/1000.0);
+        cycles = timing_now()-cycles;
+        welford_update(&timer_Sig,cycles/1000.0);
+        hdr_record(&hist_Sig,cycles);
+    }
+    uint64_t sign_alloc_calls = alloc_calls;
+    /* secret key expanded once, outside of the timed region */
+    CROSS_sk_expanded_t esk;
+    CROSS_sk_expand(&sk,&esk);
+    for(int i = 0; i <NUM_TESTS; i++) {
+        cycles = timing_now();
+        CROSS_sign_expanded(&esk,message,8,&signature);
+        welford_update(&timer_Sig_exp,(timing_now()-cycles)/1000.0);
+    }
+    CROSS_sk_expanded_zeroize(&esk);
+    /* batch signing, timed per signature */
+    const char *batch_sign_msgs[BATCH_SIZE];
+    uint64_t batch_sign_mlens[BATCH_SIZE];
+    CROSS_sig_t batch_signatures[BATCH_SIZE];
+    CROSS_sig_t *batch_sign_sigs[BATCH_SIZE];
+    for(int j = 0; j < BATCH_SIZE; j++){
+        batch_sign_msgs[j] = message;
+        batch_sign_mlens[j] = 8;
+        batch_sign_sigs[j] = &batch_signatures[j];
+    }
+    for(int i = 0; i <NUM_TESTS/BATCH_SIZE; i++) {
+        cycles = timing_now();
+        CROSS_sign_batch(&sk,BATCH_SIZE,batch_sign_msgs,batch_sign_mlens,batch_sign_sigs);
+        welford_update(&timer_Sig_batch,(timing_now()-cycles)/1000.0/BATCH_SIZE);
     }
     int is_signature_still_ok = 1;
     for(int i = 0; i <NUM_TESTS; i++) {
-        cycles = x86_64_rtdsc();
+        cycles = timing_now();
         int is_signature_ok = CROSS_verify(&pk,message,8,&signature);
-        welford_update(&timer_Ver,(x86_64_rtdsc()-cycles)/1000.0);
+        cycles = timing_now()-cycles;
+        welford_update(&timer_Ver,cycles/1000.0);
+        hdr_record(&hist_Ver,cycles);
+        is_signature_still_ok = is_signature_ok && is_signature_still_ok;
+    }
+    /* public key expanded once, outside of the timed region */
+    CROSS_pk_expanded_t epk;
+    CROSS_pk_expand(&pk,&epk);
+    for(int i = 0; i <NUM_TESTS; i++) {
+        cycles = timing_now();
+        int is_signature_ok = CROSS_verify_expanded(&epk,message,8,&signature);
+        welford_update(&timer_Ver_exp,(timing_now()-cycles)/1000.0);
         is_signature_still_ok = is_signature_ok && is_signature_still_ok;
     }
-    if(print_tex){
+    /* batch verification, timed per signature, on as many signatures as
+     * the other verification timings */
+    const char *batch_msgs[BATCH_SIZE];
+    uint64_t batch_mlens[BATCH_SIZE];
+    const CROSS_sig_t *batch_sigs[BATCH_SIZE];
+    int batch_results[BATCH_SIZE];
+    for(int j = 0; j < BATCH_SIZE; j++){
+        batch_msgs[j] = message;
+        batch_mlens[j] = 8;
+        batch_sigs[j] = &signature;
+    }
+    for(int i = 0; i <NUM_TESTS/BATCH_SIZE; i++) {
+        cycles = timing_now();
+        int is_signature_ok = CROSS_verify_batch(&pk,BATCH_SIZE,batch_msgs,
+                                                 batch_mlens,batch_sigs,batch_results);
+        welford_update(&timer_Ver_batch,(timing_now()-cycles)/1000.0/BATCH_SIZE);
+        is_signature_still_ok = is_signature_ok && is_signature_still_ok;
+    }
+    if(format == OUTPUT_JSON){
+        printf("{\"parameter_set\": \"%s\", \"sk_bytes\": %lu, "
+               "\"pk_bytes\": %lu, \"sig_bytes\": %lu, \"unit\": \"kcycles\", ",
+               parameter_set_name(), sizeof(sk_t), sizeof(pk_t), sizeof(CROSS_sig_t));
+        operation_print_json("keygen",timer_KG,&hist_KG);
+        printf(", ");
+        operation_print_json("sign",timer_Sig,&hist_Sig);
+        printf(", ");
+        operation_print_json("verify",timer_Ver,&hist_Ver);
+        printf("}\n");
+    } else if(format == OUTPUT_CSV){
+        printf("parameter_set,operation,mean,stddev,p50,p90,p99,p999,max\n");
+        operation_print_csv("keygen",timer_KG,&hist_KG);
+        operation_print_csv("sign",timer_Sig,&hist_Sig);
+        operation_print_csv("verify",timer_Ver,&hist_Ver);
+    } else if(format == OUTPUT_TEX){
       /* print a convenient machine extractable table row pair */
       printf("TIME & ");
 #if defined(RSDP)
@@ -166,21 +309,454 @@ void CROSS_sign_verify_speed(int print_tex){
         printf("Verification kCycles (avg,stddev):");
         welford_print(timer_Ver);
         printf("\n");
+
+        printf("Key generation kCycles (p50,p90,p99,p99.9,max): ");
+        hdr_print(&hist_KG);
+        printf("\n");
+
+        printf("Signature kCycles (p50,p90,p99,p99.9,max): ");
+        hdr_print(&hist_Sig);
+        printf("\n");
+
+        printf("Verification kCycles (p50,p90,p99,p99.9,max): ");
+        hdr_print(&hist_Ver);
+        printf("\n");
+
+        printf("Signature w/ expanded sk kCycles (avg,stddev):");
+        welford_print(timer_Sig_exp);
+        printf("\n");
+
+        printf("Signature in batches of %d kCycles per signature (avg,stddev):",
+               BATCH_SIZE);
+        welford_print(timer_Sig_batch);
+        printf("\n");
+
+        printf("Verification w/ expanded pk kCycles (avg,stddev):");
+        welford_print(timer_Ver_exp);
+        printf("\n");
+
+        printf("Verification in batches of %d kCycles per signature (avg,stddev):",
+               BATCH_SIZE);
+        welford_print(timer_Ver_batch);
+        printf("\n");
+        printf("Allocator calls per signature: %.2f\n",
+               (double) sign_alloc_calls / NUM_TESTS);
         fprintf(stderr,"Keygen-Sign-Verify: %s", is_signature_still_ok == 1 ? "functional\n": "not functional\n" );
     }
 }
 
+/* message length and runs for the timings of the NIST API copies */
+#define NIST_API_MESSAGE_LEN (1UL << 20)
+#define NIST_API_NUM_TESTS 100
+
+/* compares the NIST API calls copying the message in and out of the signed
+ * message against the detached and in place ones, which do not */
+void NIST_API_copy_speed(){
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES];
+    unsigned char sk[CRYPTO_SECRETKEYBYTES];
+    unsigned char *message = malloc(NIST_API_MESSAGE_LEN);
+    unsigned char *opened_message = malloc(NIST_API_MESSAGE_LEN);
+    unsigned char *signed_message = malloc(NIST_API_MESSAGE_LEN+CRYPTO_BYTES);
+    unsigned char signature[CRYPTO_BYTES];
+    unsigned long long smlen, mlen, siglen;
+    const unsigned char *message_in_place;
+    randombytes(message,NIST_API_MESSAGE_LEN);
+    crypto_sign_keypair(pk,sk);
+
+    welford_t timer_sign,timer_sign_detached,timer_open,timer_open_inplace;
+    welford_init(&timer_sign);
+    welford_init(&timer_sign_detached);
+    welford_init(&timer_open);
+    welford_init(&timer_open_inplace);
+    uint64_t cycles;
+    int are_there_problems = 0;
+    for(int i = 0; i < NIST_API_NUM_TESTS; i++) {
+        cycles = timing_now();
+        are_there_problems |= crypto_sign(signed_message,&smlen,message,
+                                          NIST_API_MESSAGE_LEN,sk);
+        welford_update(&timer_sign,(timing_now()-cycles)/1000.0);
+        cycles = timing_now();
+        are_there_problems |= crypto_sign_signature(signature,&siglen,message,
+                                                    NIST_API_MESSAGE_LEN,sk);
+        welford_update(&timer_sign_detached,(timing_now()-cycles)/1000.0);
+        cycles = timing_now();
+        are_there_problems |= crypto_sign_open(opened_message,&mlen,
+                                               signed_message,smlen,pk);
+        welford_update(&timer_open,(timing_now()-cycles)/1000.0);
+        cycles = timing_now();
+        are_there_problems |= crypto_sign_open_inplace(&message_in_place,&mlen,
+                                                       signed_message,smlen,pk);
+        welford_update(&timer_open_inplace,(timing_now()-cycles)/1000.0);
+    }
+    printf("NIST API on a %lu B message, kCycles (avg,stddev):\n",
+           NIST_API_MESSAGE_LEN);
+    printf("crypto_sign: ");
+    welford_print(timer_sign);
+    printf("\ncrypto_sign_signature (detached): ");
+    welford_print(timer_sign_detached);
+    printf("\ncrypto_sign_open: ");
+    welford_print(timer_open);
+    printf("\ncrypto_sign_open_inplace: ");
+    welford_print(timer_open_inplace);
+    printf("\n");
+    /* each avoided copy reads and writes the whole message once */
+    const long double saved_bytes = 2.0L*NIST_API_MESSAGE_LEN;
+    const long double saved_sign_kcycles = welford_mean(timer_sign) -
+                                           welford_mean(timer_sign_detached);
+    const long double saved_open_kcycles = welford_mean(timer_open) -
+                                           welford_mean(timer_open_inplace);
+    printf("Memory traffic saved per call: %.0Lf B, "
+           "sign %.2Lf kCycles (%.2Lf B/cycle), "
+           "open %.2Lf kCycles (%.2Lf B/cycle)\n",
+           saved_bytes,
+           saved_sign_kcycles, saved_bytes/(1000.0L*saved_sign_kcycles),
+           saved_open_kcycles, saved_bytes/(1000.0L*saved_open_kcycles));
+    fprintf(stderr,"NIST API: %s", are_there_problems == 0 ? "functional\n": "not functional\n" );
+    free(message);
+    free(opened_message);
+    free(signed_message);
+}
+
+/* stack of the threads measuring the stack usage: it is painted with a known
+ * pattern before running the operation, the bytes no longer matching it
+ * give the high water mark */
+#define STACK_PROBE_BYTES (8UL << 20)
+#define STACK_PROBE_PAINT 0xA5
+
+typedef enum {
+    PROBE_NONE,
+    PROBE_KEYGEN,
+    PROBE_SIGN,
+    PROBE_SIGN_WS,
+    PROBE_VERIFY,
+    NUM_PROBES
+} stack_probe_op_t;
+
+typedef struct {
+    stack_probe_op_t operation;
+    pk_t pk;
+    sk_t sk;
+    CROSS_sig_t signature;
+    void *workspace;
+    uint64_t alloc_calls;
+    int is_ok;
+} stack_probe_t;
+
+static
+void *stack_probe_main(void *probe_arg){
+    stack_probe_t *probe = (stack_probe_t *)probe_arg;
+    char message[8] = "Signme!";
+    csprng_initialize(&platform_csprng_state,
+                      (const unsigned char *)"stack-probe-0123",16,0);
+    const uint64_t alloc_calls_begin = alloc_calls;
+    switch(probe->operation){
+        case PROBE_KEYGEN:
+            CROSS_keygen(&probe->sk,&probe->pk);
+            break;
+        case PROBE_SIGN:
+            CROSS_sign(&probe->sk,message,8,&probe->signature);
+            break;
+        case PROBE_SIGN_WS:
+            probe->is_ok = CROSS_sign_ws(&probe->sk,message,8,&probe->signature,
+                                         probe->workspace,CROSS_SIGN_WORKSPACE_BYTES);
+            break;
+        case PROBE_VERIFY:
+            probe->is_ok = CROSS_verify(&probe->pk,message,8,&probe->signature);
+            break;
+        default:
+            break;
+    }
+    probe->alloc_calls = alloc_calls - alloc_calls_begin;
+    return NULL;
+}
+
+/* bytes of stack touched by a thread running the probe operation */
+static
+size_t stack_high_water(stack_probe_t *probe){
+    uint8_t *stack = aligned_alloc(4096,STACK_PROBE_BYTES);
+    if(stack == NULL){
+        fprintf(stderr,"Cannot allocate the stack of the probe thread\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(stack,STACK_PROBE_PAINT,STACK_PROBE_BYTES);
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstack(&attr,stack,STACK_PROBE_BYTES);
+    pthread_t thread;
+    int error = pthread_create(&thread,&attr,stack_probe_main,probe);
+    if(error != 0){
+        fprintf(stderr,"Cannot start the stack probe thread: %s\n",strerror(error));
+        exit(EXIT_FAILURE);
+    }
+    pthread_join(thread,NULL);
+    pthread_attr_destroy(&attr);
+    /* the stack grows downwards, from the end of the buffer */
+    size_t untouched = 0;
+    while(untouched < STACK_PROBE_BYTES && stack[untouched] == STACK_PROBE_PAINT){
+        untouched++;
+    }
+    free(stack);
+    return STACK_PROBE_BYTES - untouched;
+}
+
+/* stack high water mark and allocator calls of each operation, net of the
+ * thread start up, and scratch memory moved off the stack by CROSS_sign_ws */
+void CROSS_footprint_report(){
+    static const char *const probe_names[NUM_PROBES] = {
+        "", "CROSS_keygen", "CROSS_sign", "CROSS_sign_ws", "CROSS_verify"
+    };
+    stack_probe_t *probe = malloc(sizeof(stack_probe_t));
+    if(probe == NULL){
+        fprintf(stderr,"Cannot allocate the stack probe\n");
+        exit(EXIT_FAILURE);
+    }
+    probe->workspace = malloc(CROSS_SIGN_WORKSPACE_BYTES);
+    if(probe->workspace == NULL){
+        fprintf(stderr,"Cannot allocate the %zu B signature workspace\n",
+                (size_t) CROSS_SIGN_WORKSPACE_BYTES);
+        exit(EXIT_FAILURE);
+    }
+    probe->is_ok = 1;
+    int is_signature_still_ok = 1;
+    size_t baseline = 0;
+    printf("Stack high water mark (B), allocator calls:\n");
+    for(int op = PROBE_NONE; op < NUM_PROBES; op++){
+        probe->operation = (stack_probe_op_t) op;
+        const size_t high_water = stack_high_water(probe);
+        is_signature_still_ok = is_signature_still_ok && probe->is_ok;
+        if(op == PROBE_NONE){
+            baseline = high_water;
+            continue;
+        }
+        printf("%-14s %8zu %4" PRIu64 "\n", probe_names[op], high_water-baseline,
+               probe->alloc_calls);
+    }
+    printf("CROSS_sign_ws workspace (B): %zu\n", (size_t) CROSS_SIGN_WORKSPACE_BYTES);
+    free(probe->workspace);
+    free(probe);
+    fprintf(stderr,"Footprint: %s", is_signature_still_ok == 1 ? "functional\n": "not functional\n" );
+}
+
+#if defined(CROSS_STATS)
+static
+void CROSS_stats_print(const char *operation){
+    static const char *const phase_names[CROSS_NUM_PHASES] = {
+        "key expansion", "seed tree", "rounds", "Merkle root",
+        "first challenge", "y computation and packing",
+        "second challenge", "proof and path"
+    };
+    CROSS_stats_t stats;
+    CROSS_stats_get(&stats);
+    printf("Keccak permutations per %s: %" PRIu64 " (calls x1: %" PRIu64
+           ", x2: %" PRIu64 ", x4: %" PRIu64 ", x8: %" PRIu64 ")\n",
+           operation,
+           stats.keccak_calls_x1 + 2*stats.keccak_calls_x2 +
+           4*stats.keccak_calls_x4 + 8*stats.keccak_calls_x8,
+           stats.keccak_calls_x1, stats.keccak_calls_x2,
+           stats.keccak_calls_x4, stats.keccak_calls_x8);
+    printf("SHAKE bytes per %s: absorbed %" PRIu64 ", squeezed %" PRIu64 "\n",
+           operation, stats.bytes_absorbed, stats.bytes_squeezed);
+    for(int i = 0; i < CROSS_NUM_PHASES; i++){
+        if(stats.phase_cycles[i] != 0){
+            printf("  %-26s %10" PRIu64 "\n", phase_names[i], stats.phase_cycles[i]);
+        }
+    }
+}
+
+/* reports the instrumentation counts of a single signature and a single
+ * verification, key expansion included */
+void CROSS_stats_report(){
+    pk_t pk;
+    sk_t sk;
+    CROSS_sig_t signature;
+    char message[8] = "Signme!";
+    CROSS_keygen(&sk,&pk);
+    CROSS_stats_reset();
+    CROSS_sign(&sk,message,8,&signature);
+    CROSS_stats_print("signature");
+    CROSS_stats_reset();
+    CROSS_verify(&pk,message,8,&signature);
+    CROSS_stats_print("verification");
+}
+#endif
+
+/* signatures and verifications per thread in the throughput timings */
+#define THROUGHPUT_NUM_TESTS 200
+
+typedef struct {
+    int thread_id;
+    pthread_barrier_t *barrier;
+    welford_t timer_Sig;
+    welford_t timer_Ver;
+    /* events counted over the signatures, with the perf_event backend */
+    perf_counts_t sign_counts;
+    int is_signature_still_ok;
+} throughput_thread_t;
+
+/* signs and verifies with a key pair and message of its own, the barrier
+ * marks the start and end of the signatures and of the verifications */
+static
+void *throughput_thread_main(void *thread_arg){
+    throughput_thread_t *thread = (throughput_thread_t *)thread_arg;
+    unsigned char thread_seed[16] = "thread-xxxxxxxxx";
+    memcpy(thread_seed+7, &thread->thread_id, sizeof(int));
+    csprng_initialize(&platform_csprng_state, thread_seed, 16, 0);
+    /* the performance counters are per thread */
+    timing_init();
+
+    pk_t pk;
+    sk_t sk;
+    CROSS_sig_t signature;
+    char message[32];
+    randombytes((unsigned char *)message, sizeof(message));
+    CROSS_keygen(&sk,&pk);
+    welford_init(&thread->timer_Sig);
+    welford_init(&thread->timer_Ver);
+    thread->is_signature_still_ok = 1;
+
+    uint64_t cycles;
+    perf_counts_t begin, end;
+    memset(&thread->sign_counts, 0, sizeof(perf_counts_t));
+    pthread_barrier_wait(thread->barrier);
+    perf_counts_read(&begin);
+    for(int i = 0; i < THROUGHPUT_NUM_TESTS; i++) {
+        cycles = timing_now();
+        CROSS_sign(&sk,message,sizeof(message),&signature);
+        welford_update(&thread->timer_Sig,(timing_now()-cycles)/1000.0);
+    }
+    perf_counts_read(&end);
+    perf_counts_accumulate(&thread->sign_counts, &begin, &end);
+    pthread_barrier_wait(thread->barrier);
+    for(int i = 0; i < THROUGHPUT_NUM_TESTS; i++) {
+        cycles = timing_now();
+        int is_signature_ok = CROSS_verify(&pk,message,sizeof(message),&signature);
+        welford_update(&thread->timer_Ver,(timing_now()-cycles)/1000.0);
+        thread->is_signature_still_ok = is_signature_ok && thread->is_signature_still_ok;
+    }
+    pthread_barrier_wait(thread->barrier);
+    timing_release();
+    return NULL;
+}
+
+static
+double elapsed_seconds(const struct timespec *begin, const struct timespec *end){
+    return (double)(end->tv_sec - begin->tv_sec) +
+           (double)(end->tv_nsec - begin->tv_nsec) / 1e9;
+}
+
+/* aggregate signatures and verifications per second of num_threads
+ * concurrent signers, for 1, 2, 4, ... and num_threads threads. The scaling
+ * efficiency is the throughput relative to num_threads single threads. The
+ * L1D and last level cache misses per signature are reported with the
+ * perf_event backend, n/a otherwise */
+void CROSS_throughput_speed(const int num_threads){
+    fprintf(stderr,"Computing throughput over %d signatures and verifications per thread\n",
+            THROUGHPUT_NUM_TESTS);
+    throughput_thread_t *threads = malloc(num_threads*sizeof(throughput_thread_t));
+    pthread_t *thread_ids = malloc(num_threads*sizeof(pthread_t));
+    if(threads == NULL || thread_ids == NULL){
+        fprintf(stderr,"Cannot allocate the state of %d threads, rerun with a lower -j\n",
+                num_threads);
+        exit(EXIT_FAILURE);
+    }
+    double sign_ops_single = 0, verify_ops_single = 0;
+    int is_signature_still_ok = 1;
+
+    printf("threads,sign/s,verify/s,sign kCycles (avg,stddev),"
+           "verify kCycles (avg,stddev),sign efficiency,verify efficiency,"
+           "sign L1D misses,sign LLC misses\n");
+    for(int n = 1; ; n = (2*n < num_threads) ? 2*n : num_threads){
+        pthread_barrier_t barrier;
+        pthread_barrier_init(&barrier, NULL, n+1);
+        for(int t = 0; t < n; t++){
+            threads[t].thread_id = t;
+            threads[t].barrier = &barrier;
+            /* the threads already started wait on the barrier for all the
+             * n, hence the measurement cannot go on with fewer of them */
+            int error = pthread_create(&thread_ids[t], NULL, throughput_thread_main, &threads[t]);
+            if(error != 0){
+                fprintf(stderr,"Cannot start thread %d of %d: %s, rerun with a lower -j\n",
+                        t+1, n, strerror(error));
+                exit(EXIT_FAILURE);
+            }
+        }
+        struct timespec begin, signed_all, verified_all;
+        pthread_barrier_wait(&barrier);
+        clock_gettime(CLOCK_MONOTONIC, &begin);
+        pthread_barrier_wait(&barrier);
+        clock_gettime(CLOCK_MONOTONIC, &signed_all);
+        pthread_barrier_wait(&barrier);
+        clock_gettime(CLOCK_MONOTONIC, &verified_all);
+
+        welford_t timer_Sig, timer_Ver;
+        welford_init(&timer_Sig);
+        welford_init(&timer_Ver);
+        uint64_t sign_l1d_misses = 0, sign_llc_misses = 0;
+        for(int t = 0; t < n; t++){
+            pthread_join(thread_ids[t], NULL);
+            welford_combine(&timer_Sig, threads[t].timer_Sig);
+            welford_combine(&timer_Ver, threads[t].timer_Ver);
+            sign_l1d_misses += threads[t].sign_counts.count[PERF_L1D_MISSES];
+            sign_llc_misses += threads[t].sign_counts.count[PERF_LLC_MISSES];
+            is_signature_still_ok = is_signature_still_ok && threads[t].is_signature_still_ok;
+        }
+        pthread_barrier_destroy(&barrier);
+
+        double sign_ops = n * THROUGHPUT_NUM_TESTS / elapsed_seconds(&begin, &signed_all);
+        double verify_ops = n * THROUGHPUT_NUM_TESTS / elapsed_seconds(&signed_all, &verified_all);
+        if(n == 1){
+            sign_ops_single = sign_ops;
+            verify_ops_single = verify_ops;
+        }
+        printf("%d,%.1f,%.1f,", n, sign_ops, verify_ops);
+        welford_print(timer_Sig);
+        printf(",");
+        welford_print(timer_Ver);
+        printf(",%.3f,%.3f", sign_ops / (n * sign_ops_single),
+               verify_ops / (n * verify_ops_single));
+        if(timing_state()->backend == TIMING_PERF_EVENT){
+            printf(",%.1f,%.1f\n",
+                   (double) sign_l1d_misses / (n * THROUGHPUT_NUM_TESTS),
+                   (double) sign_llc_misses / (n * THROUGHPUT_NUM_TESTS));
+        } else {
+            printf(",n/a,n/a\n");
+        }
+        if(n == num_threads){
+            break;
+        }
+    }
+    free(threads);
+    free(thread_ids);
+    fprintf(stderr,"Keygen-Sign-Verify: %s", is_signature_still_ok == 1 ? "functional\n": "not functional\n" );
+}
 
 int main(int argc, char* argv[]){
     csprng_initialize(&platform_csprng_state,
                       (const unsigned char *)"0123456789012345",16,0);
     fprintf(stderr,"CROSS reference implementation benchmarking tool\n");
+    timing_init();
+    fprintf(stderr,"Timing backend: %s\n", timing_backend_name());
     if ( (argc>1) &&
          (argv[1][0] == '-' ) &&
          (argv[1][1] == 'T' )){
-        CROSS_sign_verify_speed(1);
+        CROSS_sign_verify_speed(OUTPUT_TEX);
+    } else if ( (argc>1) &&
+                (strcmp(argv[1],"-J") == 0) ){
+        CROSS_sign_verify_speed(OUTPUT_JSON);
+    } else if ( (argc>1) &&
+                (strcmp(argv[1],"-C") == 0) ){
+        CROSS_sign_verify_speed(OUTPUT_CSV);
+    } else if ( (argc>2) &&
+                (strcmp(argv[1],"-j") == 0) &&
+                (atoi(argv[2]) > 0) ){
+        CROSS_throughput_speed(atoi(argv[2]));
     } else {
-        CROSS_sign_verify_speed(0);
+        CROSS_sign_verify_speed(OUTPUT_TEXT);
+        NIST_API_copy_speed();
+        CROSS_footprint_report();
+#if defined(CROSS_STATS)
+        CROSS_stats_report();
+#endif
     }
     return 0;
 }
@@ -0,0 +1,348 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.2 (July 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "timing_and_stat.h"
+#include "csprng_hash.h"
+#include "fp_arith.h"
+#include "pack_unpack.h"
+#include "CROSS.h"
+#include "rng.h"
+
+#define NUM_TESTS 10000
+
+#if defined(RSDP)
+#define CMT_0_INPUT_BYTES (DENSELY_PACKED_FP_SYN_SIZE+DENSELY_PACKED_FZ_VEC_SIZE+SALT_LENGTH_BYTES)
+#elif defined(RSDPG)
+#define CMT_0_INPUT_BYTES (DENSELY_PACKED_FP_SYN_SIZE+DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE+SALT_LENGTH_BYTES)
+#endif
+
+/* kernel outputs are read back through a volatile pointer, so that the
+ * compiler cannot drop a kernel whose result is otherwise unused */
+static uint8_t kernel_sink;
+
+static
+void kernel_consume(const void *const out){
+    kernel_sink ^= *(const volatile uint8_t *)out;
+}
+
+/* cycles per call, followed by the instructions per cycle and the L1D,
+ * last level cache and branch misses per call when the perf_event backend
+ * counts them */
+static
+void kernel_print(const char *const name, const welford_t timer,
+                  const perf_counts_t *total, const long runs){
+    printf("%-32s ", name);
+    welford_print(timer);
+    if(timing_state()->backend == TIMING_PERF_EVENT){
+        printf(",%.2f,%.2f,%.2f,%.2f",
+               (double)total->count[PERF_INSTRUCTIONS] /
+               (double)total->count[PERF_CYCLES],
+               (double)total->count[PERF_L1D_MISSES] / runs,
+               (double)total->count[PERF_LLC_MISSES] / runs,
+               (double)total->count[PERF_BRANCH_MISSES] / runs);
+    }
+    printf("\n");
+}
+
+/* times runs calls to a kernel: the statement setup prepares its inputs
+ * outside of the timed region, the compiler barriers keep the kernel from
+ * being moved across the counter reads */
+#define TIME_KERNEL_RUNS(name, runs, setup, kernel, out) do {        \
+    welford_t timer;                                                 \
+    welford_init(&timer);                                            \
+    perf_counts_t total = {{0}}, begin, end;                         \
+    for(int i = 0; i < (runs); i++){                                 \
+        setup;                                                       \
+        __asm__ __volatile__("" ::: "memory");                       \
+        perf_counts_read(&begin);                                    \
+        kernel;                                                      \
+        __asm__ __volatile__("" ::: "memory");                       \
+        perf_counts_read(&end);                                      \
+        welford_update(&timer, end.count[PERF_CYCLES]-begin.count[PERF_CYCLES]); \
+        perf_counts_accumulate(&total, &begin, &end);                \
+        kernel_consume(out);                                         \
+    }                                                                \
+    kernel_print(name, timer, &total, (runs));                       \
+} while(0)
+
+#define TIME_KERNEL(name, setup, kernel, out) \
+    TIME_KERNEL_RUNS(name, NUM_TESTS, setup, kernel, out)
+
+/* inputs of the kernels, sampled once at startup */
+static FP_ELEM fp_vec[N];
+static FZ_ELEM fz_vec[N];
+#if defined(RSDPG)
+static FZ_ELEM fz_inf_w[M];
+#endif
+static FP_ELEM V_tr[K][N-K];
+static CROSS_pk_expanded_t EPK;
+static uint8_t seed[SEED_LENGTH_BYTES+SALT_LENGTH_BYTES];
+static uint8_t digest[HASH_DIGEST_LENGTH];
+
+static
+void kernel_inputs_init(){
+    pk_t pk;
+    sk_t sk;
+    CROSS_keygen(&sk,&pk);
+    CROSS_pk_expand(&pk,&EPK);
+
+    randombytes(seed,sizeof(seed));
+    randombytes(digest,sizeof(digest));
+    CSPRNG_STATE_T csprng_state;
+    csprng_initialize(&csprng_state,seed,sizeof(seed),CSPRNG_DOMAIN_SEP_CONST);
+    csprng_fp_vec(fp_vec,&csprng_state);
+#if defined(RSDP)
+    csprng_fz_vec(fz_vec,&csprng_state);
+#elif defined(RSDPG)
+    csprng_fz_inf_w(fz_inf_w,&csprng_state);
+    fz_inf_w_by_fz_matrix(fz_vec,fz_inf_w,EPK.W_mat);
+    fz_dz_norm_n(fz_vec);
+#endif
+    csprng_fp_mat(V_tr,&csprng_state);
+}
+
+void arith_kernels_speed(){
+    FP_ELEM res_syn[N-K];
+    FP_ELEM res_vec[N];
+    const FP_ELEM chall_1 = fp_vec[0];
+
+    TIME_KERNEL("fp_vec_by_fp_matrix", ,
+                fp_vec_by_fp_matrix(res_syn,fp_vec,EPK.V_tr), res_syn);
+    TIME_KERNEL("restr_vec_by_fp_matrix", ,
+                restr_vec_by_fp_matrix(res_syn,fz_vec,V_tr), res_syn);
+    TIME_KERNEL("fp_vec_by_restr_vec_scaled", ,
+                fp_vec_by_restr_vec_scaled(res_vec,fz_vec,chall_1,fp_vec), res_vec);
+#if defined(RSDPG)
+    FZ_ELEM res_fz[N];
+    TIME_KERNEL("fz_inf_w_by_fz_matrix", ,
+                fz_inf_w_by_fz_matrix(res_fz,fz_inf_w,EPK.W_mat), res_fz);
+#endif
+    TIME_KERNEL("convert_restr_vec_to_fp", ,
+                convert_restr_vec_to_fp(res_vec,fz_vec), res_vec);
+}
+
+/* the samplers are timed from an initialized CSPRNG state */
+void csprng_kernels_speed(){
+    CSPRNG_STATE_T csprng_state;
+    const uint16_t dsc = CSPRNG_DOMAIN_SEP_CONST;
+#define CSPRNG_SETUP csprng_initialize(&csprng_state,seed,sizeof(seed),dsc)
+
+    FP_ELEM res_fp_vec[N];
+    TIME_KERNEL("csprng_fp_vec", CSPRNG_SETUP,
+                csprng_fp_vec(res_fp_vec,&csprng_state), res_fp_vec);
+    FP_ELEM res_chall_1[T];
+    TIME_KERNEL("csprng_fp_vec_chall_1", CSPRNG_SETUP,
+                csprng_fp_vec_chall_1(res_chall_1,&csprng_state), res_chall_1);
+    static FP_ELEM res_fp_mat[K][N-K];
+    TIME_KERNEL("csprng_fp_mat", CSPRNG_SETUP,
+                csprng_fp_mat(res_fp_mat,&csprng_state), res_fp_mat);
+#if defined(RSDP)
+    FZ_ELEM res_fz_vec[N];
+    TIME_KERNEL("csprng_fz_vec", CSPRNG_SETUP,
+                csprng_fz_vec(res_fz_vec,&csprng_state), res_fz_vec);
+#elif defined(RSDPG)
+    FZ_ELEM res_fz_inf_w[M];
+    TIME_KERNEL("csprng_fz_inf_w", CSPRNG_SETUP,
+                csprng_fz_inf_w(res_fz_inf_w,&csprng_state), res_fz_inf_w);
+    static FZ_ELEM res_fz_mat[M][N-M];
+    TIME_KERNEL("csprng_fz_mat", CSPRNG_SETUP,
+                csprng_fz_mat(res_fz_mat,&csprng_state), res_fz_mat);
+#endif
+#undef CSPRNG_SETUP
+
+#if defined(PAR_HASH_WAYS)
+    /* parallel samplers, timed with all the PAR_HASH_WAYS states in use */
+    PAR8_CSPRNG_STATE_T par_states;
+    const unsigned char *seeds[PAR_HASH_WAYS];
+    uint16_t dscs[PAR_HASH_WAYS];
+    FP_ELEM par_fp_vec[PAR_HASH_WAYS][N];
+    FP_ELEM par_chall_1[PAR_HASH_WAYS][T];
+    FP_ELEM *par_fp_vec_ptrs[PAR_HASH_WAYS];
+    FP_ELEM *par_chall_1_ptrs[PAR_HASH_WAYS];
+#if defined(RSDP)
+    FZ_ELEM par_fz_vec[PAR_HASH_WAYS][N];
+    FZ_ELEM *par_fz_vec_ptrs[PAR_HASH_WAYS];
+#elif defined(RSDPG)
+    FZ_ELEM par_fz_inf_w[PAR_HASH_WAYS][M];
+    FZ_ELEM *par_fz_inf_w_ptrs[PAR_HASH_WAYS];
+#endif
+    for(int j = 0; j < PAR_HASH_WAYS; j++){
+        seeds[j] = seed;
+        dscs[j] = dsc+j;
+        par_fp_vec_ptrs[j] = par_fp_vec[j];
+        par_chall_1_ptrs[j] = par_chall_1[j];
+#if defined(RSDP)
+        par_fz_vec_ptrs[j] = par_fz_vec[j];
+#elif defined(RSDPG)
+        par_fz_inf_w_ptrs[j] = par_fz_inf_w[j];
+#endif
+    }
+#define CSPRNG_PAR_SETUP \
+    csprng_initialize_par8(PAR_HASH_WAYS,&par_states,seeds,sizeof(seed),dscs)
+
+    TIME_KERNEL("csprng_fp_vec_par8", CSPRNG_PAR_SETUP,
+                csprng_fp_vec_par8(PAR_HASH_WAYS,par_fp_vec_ptrs,&par_states),
+                par_fp_vec);
+    TIME_KERNEL("csprng_fp_vec_chall_1_par8", CSPRNG_PAR_SETUP,
+                csprng_fp_vec_chall_1_par8(PAR_HASH_WAYS,par_chall_1_ptrs,&par_states),
+                par_chall_1);
+#if defined(RSDP)
+    TIME_KERNEL("csprng_fz_vec_par8", CSPRNG_PAR_SETUP,
+                csprng_fz_vec_par8(PAR_HASH_WAYS,par_fz_vec_ptrs,&par_states),
+                par_fz_vec);
+#elif defined(RSDPG)
+    TIME_KERNEL("csprng_fz_inf_w_par8", CSPRNG_PAR_SETUP,
+                csprng_fz_inf_w_par8(PAR_HASH_WAYS,par_fz_inf_w_ptrs,&par_states),
+                par_fz_inf_w);
+#endif
+#undef CSPRNG_PAR_SETUP
+#endif
+
+    uint8_t chall_2[T];
+    TIME_KERNEL("expand_digest_to_fixed_weight", ,
+                expand_digest_to_fixed_weight(chall_2,digest), chall_2);
+}
+
+void pack_unpack_kernels_speed(){
+    uint8_t packed_fp_vec[DENSELY_PACKED_FP_VEC_SIZE];
+    uint8_t packed_fp_syn[DENSELY_PACKED_FP_SYN_SIZE];
+    uint8_t packed_fz_vec[DENSELY_PACKED_FZ_VEC_SIZE];
+    FP_ELEM res_fp_vec[N];
+    FP_ELEM res_fp_syn[N-K];
+    FZ_ELEM res_fz_vec[N];
+    uint8_t is_padd_ok = 1;
+
+    TIME_KERNEL("pack_fp_vec", ,
+                pack_fp_vec(packed_fp_vec,fp_vec), packed_fp_vec);
+    TIME_KERNEL("pack_fp_syn", ,
+                pack_fp_syn(packed_fp_syn,fp_vec), packed_fp_syn);
+    TIME_KERNEL("pack_fz_vec", ,
+                pack_fz_vec(packed_fz_vec,fz_vec), packed_fz_vec);
+    TIME_KERNEL("unpack_fp_vec", ,
+                is_padd_ok &= unpack_fp_vec(res_fp_vec,packed_fp_vec), res_fp_vec);
+    TIME_KERNEL("unpack_fp_syn", ,
+                is_padd_ok &= unpack_fp_syn(res_fp_syn,packed_fp_syn), res_fp_syn);
+    TIME_KERNEL("unpack_fz_vec", ,
+                is_padd_ok &= unpack_fz_vec(res_fz_vec,packed_fz_vec), res_fz_vec);
+#if defined(RSDPG)
+    uint8_t packed_fz_rsdp_g_vec[DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE];
+    FZ_ELEM res_fz_rsdp_g_vec[M];
+    TIME_KERNEL("pack_fz_rsdp_g_vec", ,
+                pack_fz_rsdp_g_vec(packed_fz_rsdp_g_vec,fz_inf_w),
+                packed_fz_rsdp_g_vec);
+    TIME_KERNEL("unpack_fz_rsdp_g_vec", ,
+                is_padd_ok &= unpack_fz_rsdp_g_vec(res_fz_rsdp_g_vec,packed_fz_rsdp_g_vec),
+                res_fz_rsdp_g_vec);
+#endif
+    if(!is_padd_ok){
+        fprintf(stderr,"pack/unpack: padding check failed\n");
+    }
+}
+
+/* hashes of commitment sized inputs, the parallel ones at each par_level */
+void hash_kernels_speed(){
+    uint8_t input[CMT_0_INPUT_BYTES];
+    randombytes(input,sizeof(input));
+    uint8_t out[HASH_DIGEST_LENGTH];
+    TIME_KERNEL("hash", ,
+                hash(out,input,sizeof(input),HASH_DOMAIN_SEP_CONST), out);
+#if defined(PAR_HASH_WAYS)
+    char name[64];
+    uint8_t par_out[PAR_HASH_WAYS][HASH_DIGEST_LENGTH];
+    for(int par_level = 1; par_level <= 4; par_level++){
+        snprintf(name,sizeof(name),"hash_par (par_level %d)",par_level);
+        TIME_KERNEL(name, ,
+                    hash_par(par_level,
+                             par_out[0],par_out[1],par_out[2],par_out[3],
+                             input,input,input,input,sizeof(input),
+                             HASH_DOMAIN_SEP_CONST,HASH_DOMAIN_SEP_CONST+1,
+                             HASH_DOMAIN_SEP_CONST+2,HASH_DOMAIN_SEP_CONST+3),
+                    par_out);
+    }
+    uint8_t *digests[PAR_HASH_WAYS];
+    const unsigned char *inputs[PAR_HASH_WAYS];
+    uint16_t dscs[PAR_HASH_WAYS];
+    for(int j = 0; j < PAR_HASH_WAYS; j++){
+        digests[j] = par_out[j];
+        inputs[j] = input;
+        dscs[j] = HASH_DOMAIN_SEP_CONST+j;
+    }
+    for(int par_level = 1; par_level <= PAR_HASH_WAYS; par_level++){
+        snprintf(name,sizeof(name),"hash_par8 (par_level %d)",par_level);
+        TIME_KERNEL(name, ,
+                    hash_par8(par_level,digests,inputs,sizeof(input),dscs),
+                    par_out);
+    }
+#endif
+}
+
+/* whole signatures and verifications, for the counters per signature */
+#define NUM_SIGN_TESTS 100
+
+void sign_verify_speed(){
+    pk_t pk;
+    sk_t sk;
+    CROSS_sig_t signature;
+    char message[8] = "Signme!";
+    int is_signature_ok = 1;
+    CROSS_keygen(&sk,&pk);
+    TIME_KERNEL_RUNS("CROSS_sign", NUM_SIGN_TESTS, ,
+                     CROSS_sign(&sk,message,sizeof(message),&signature),
+                     &signature);
+    TIME_KERNEL_RUNS("CROSS_verify", NUM_SIGN_TESTS, ,
+                     is_signature_ok &= CROSS_verify(&pk,message,sizeof(message),&signature),
+                     &is_signature_ok);
+    if(!is_signature_ok){
+        fprintf(stderr,"CROSS_verify: signature rejected\n");
+    }
+}
+
+int main(){
+    csprng_initialize(&platform_csprng_state,
+                      (const unsigned char *)"0123456789012345",16,0);
+    fprintf(stderr,"CROSS kernel benchmarking tool\n");
+    timing_init();
+    fprintf(stderr,"Timing backend: %s\n", timing_backend_name());
+    fprintf(stderr,"Computing number of clock cycles as the average of %d runs\n", NUM_TESTS);
+    printf("%-32s cycles (avg,stddev)%s\n","kernel",
+           timing_state()->backend == TIMING_PERF_EVENT ?
+           ",IPC,L1D misses,LLC misses,branch misses" : "");
+    kernel_inputs_init();
+    arith_kernels_speed();
+    csprng_kernels_speed();
+    pack_unpack_kernels_speed();
+    hash_kernels_speed();
+    sign_verify_speed();
+    timing_release();
+    return 0;
+}
@@ -72,6 +72,266 @@ int CROSS_sign_verify_test(){
     return is_signature_ok;
 }
 
+/* returns 1 if the test is successful, 0 otherwise */
+int CROSS_expanded_pk_verify_test(){
+    pk_t pk;
+    sk_t sk;
+    CROSS_pk_expanded_t epk;
+    CROSS_sig_t signature;
+    char message[8] = "Signme!";
+    CROSS_keygen(&sk,&pk);
+    CROSS_pk_expand(&pk,&epk);
+    /* the same expanded key is employed for multiple verifications */
+    int is_signature_ok = 1;
+    for(int i = 0; i < 2; i++){
+        message[0] = 'A'+i;
+        CROSS_sign(&sk,message,8,&signature);
+        is_signature_ok = is_signature_ok &&
+                          CROSS_verify_expanded(&epk,message,8,&signature);
+    }
+    return is_signature_ok;
+}
+
+#define BATCH_SIZE 5
+int CROSS_verify_batch_test(){
+    pk_t pk;
+    sk_t sk;
+    CROSS_sig_t signatures[BATCH_SIZE];
+    char messages[BATCH_SIZE][8];
+    const char *msgs[BATCH_SIZE];
+    uint64_t mlens[BATCH_SIZE];
+    const CROSS_sig_t *sigs[BATCH_SIZE];
+    int results[BATCH_SIZE];
+    CROSS_keygen(&sk,&pk);
+    /* distinct messages of distinct lengths, the batch is not a multiple
+     * of the number of parallel Keccak instances */
+    for(int i = 0; i < BATCH_SIZE; i++){
+        memcpy(messages[i],"Signme!",8);
+        messages[i][0] = 'A'+i;
+        msgs[i] = messages[i];
+        mlens[i] = 8-i;
+        sigs[i] = &signatures[i];
+        CROSS_sign(&sk,msgs[i],mlens[i],&signatures[i]);
+    }
+    int is_batch_ok = CROSS_verify_batch(&pk,BATCH_SIZE,msgs,mlens,sigs,results);
+    for(int i = 0; i < BATCH_SIZE; i++){
+        is_batch_ok = is_batch_ok && (results[i] == 1);
+    }
+    /* tamper with the salt of one signature, changing its lane of the first
+     * challenge derivation, and with one message, both in the middle of
+     * the first group of parallel Keccak instances: only their verdicts
+     * must change */
+    signatures[1].salt[0] ^= 1;
+    messages[2][1] ^= 1;
+    int is_tampered_batch_ok = CROSS_verify_batch(&pk,BATCH_SIZE,msgs,mlens,
+                                                  sigs,results);
+    is_batch_ok = is_batch_ok && (is_tampered_batch_ok == 0);
+    for(int i = 0; i < BATCH_SIZE; i++){
+        is_batch_ok = is_batch_ok && (results[i] == (i != 1 && i != 2));
+    }
+    return is_batch_ok;
+}
+
+int CROSS_sign_batch_test(){
+    pk_t pk;
+    sk_t sk;
+    CROSS_sig_t signatures[BATCH_SIZE];
+    char messages[BATCH_SIZE][8];
+    const char *msgs[BATCH_SIZE];
+    uint64_t mlens[BATCH_SIZE];
+    CROSS_sig_t *sigs[BATCH_SIZE];
+    CROSS_keygen(&sk,&pk);
+    for(int i = 0; i < BATCH_SIZE; i++){
+        memcpy(messages[i],"Signme!",8);
+        messages[i][0] = 'A'+i;
+        msgs[i] = messages[i];
+        mlens[i] = 8-i;
+        sigs[i] = &signatures[i];
+    }
+    CROSS_sign_batch(&sk,BATCH_SIZE,msgs,mlens,sigs);
+    int is_batch_ok = 1;
+    for(int i = 0; i < BATCH_SIZE; i++){
+        is_batch_ok = is_batch_ok && CROSS_verify(&pk,msgs[i],mlens[i],sigs[i]);
+    }
+    return is_batch_ok;
+}
+
+int CROSS_expanded_sk_sign_test(){
+    pk_t pk;
+    sk_t sk;
+    CROSS_sk_expanded_t esk;
+    CROSS_sig_t signature;
+    char message[8] = "Signme!";
+    CROSS_keygen(&sk,&pk);
+    CROSS_sk_expand(&sk,&esk);
+    /* the same expanded key is employed for multiple signatures */
+    int is_signature_ok = 1;
+    for(int i = 0; i < 2; i++){
+        message[0] = 'A'+i;
+        CROSS_sign_expanded(&esk,message,8,&signature);
+        is_signature_ok = is_signature_ok &&
+                          CROSS_verify(&pk,message,8,&signature);
+    }
+    /* no secret material is left after zeroization */
+    CROSS_sk_expanded_zeroize(&esk);
+    uint8_t residual = 0;
+    for(size_t i = 0; i < sizeof(esk); i++){
+        residual |= ((uint8_t *) &esk)[i];
+    }
+    return is_signature_ok && (residual == 0);
+}
+
+/* runs the jobs one after the other, standing in for a thread pool */
+static void serial_executor_run(void *pool,
+                                void (*job)(void *arg, int worker),
+                                void *arg,
+                                int num_workers){
+    (void) pool;
+    for(int w = num_workers-1; w >= 0; w--){
+        job(arg,w);
+    }
+}
+
+#if !defined(LOW_MEMORY_SIGN)
+int CROSS_threaded_sign_test(){
+    pk_t pk;
+    sk_t sk;
+    CROSS_sk_expanded_t esk;
+    CROSS_sig_t reference, signature;
+    char message[8] = "Signme!";
+    CROSS_keygen(&sk,&pk);
+    CROSS_sk_expand(&sk,&esk);
+    const CROSS_executor_t executors[2] = {
+        {.num_workers = 3, .run = NULL, .pool = NULL},
+        {.num_workers = 4, .run = serial_executor_run, .pool = NULL}
+    };
+    /* the same salt and root seed are drawn by all the signatures, which
+     * must then be bitwise identical to the single threaded one */
+    CSPRNG_STATE_T rng_checkpoint = platform_csprng_state;
+    CROSS_sign_expanded(&esk,message,8,&reference);
+    int is_signature_ok = CROSS_verify(&pk,message,8,&reference);
+    for(int i = 0; i < 2; i++){
+        platform_csprng_state = rng_checkpoint;
+        CROSS_sign_expanded_threaded(&esk,message,8,&signature,&executors[i]);
+        is_signature_ok = is_signature_ok &&
+                          (memcmp(&reference,&signature,sizeof(CROSS_sig_t)) == 0);
+    }
+    CROSS_sk_expanded_zeroize(&esk);
+    return is_signature_ok;
+}
+#endif
+
+int CROSS_threaded_verify_test(){
+    pk_t pk;
+    sk_t sk;
+    CROSS_pk_expanded_t epk;
+    CROSS_sig_t signature;
+    char message[8] = "Signme!";
+    CROSS_keygen(&sk,&pk);
+    CROSS_sign(&sk,message,8,&signature);
+    CROSS_pk_expand(&pk,&epk);
+    const CROSS_executor_t executors[3] = {
+        {.num_workers = 2, .run = NULL, .pool = NULL},
+        {.num_workers = 5, .run = serial_executor_run, .pool = NULL},
+        /* more workers than batches of rounds, some are left idle */
+        {.num_workers = T, .run = serial_executor_run, .pool = NULL}
+    };
+    int is_signature_ok = 1;
+    for(int i = 0; i < 3; i++){
+        is_signature_ok = is_signature_ok &&
+                          CROSS_verify_expanded_threaded(&epk,message,8,&signature,&executors[i]);
+    }
+    /* set a padding bit of the last y in the signature: its round lies past
+     * the share of worker 0, and only the verdict of the worker checking it
+     * changes, as y is packed again before being hashed. A reduction of the
+     * per worker verdicts dropping that worker accepts the signature */
+    CROSS_sig_t tampered = signature;
+    tampered.resp_0[T-W-1].y[DENSELY_PACKED_FP_VEC_SIZE-1] ^= 0x80;
+    for(int i = 0; i < 3; i++){
+        is_signature_ok = is_signature_ok &&
+                          !CROSS_verify_expanded_threaded(&epk,message,8,&tampered,&executors[i]);
+    }
+    tampered = signature;
+    tampered.digest_chall_2[0] ^= 1;
+    for(int i = 0; i < 3; i++){
+        is_signature_ok = is_signature_ok &&
+                          !CROSS_verify_expanded_threaded(&epk,message,8,&tampered,&executors[i]);
+    }
+    return is_signature_ok;
+}
+
+#define STREAMING_TEST_MESSAGE_LEN 1000
+
+int CROSS_streaming_test(){
+    pk_t pk;
+    sk_t sk;
+    CROSS_sig_t reference, signature;
+    char message[STREAMING_TEST_MESSAGE_LEN];
+    CROSS_keygen(&sk,&pk);
+    randombytes((unsigned char *) message,STREAMING_TEST_MESSAGE_LEN);
+    /* the streamed signature matches the one computed on the whole message */
+    CSPRNG_STATE_T rng_checkpoint = platform_csprng_state;
+    CROSS_sign(&sk,message,STREAMING_TEST_MESSAGE_LEN,&reference);
+    platform_csprng_state = rng_checkpoint;
+    CROSS_sign_ctx_t sign_ctx;
+    CROSS_sign_init(&sign_ctx);
+    /* chunks of growing length, including an empty one */
+    uint64_t absorbed = 0;
+    for(uint64_t chunk_len = 0; absorbed < STREAMING_TEST_MESSAGE_LEN; chunk_len += 7){
+        if(chunk_len > STREAMING_TEST_MESSAGE_LEN-absorbed){
+            chunk_len = STREAMING_TEST_MESSAGE_LEN-absorbed;
+        }
+        CROSS_sign_update(&sign_ctx,message+absorbed,chunk_len);
+        absorbed += chunk_len;
+    }
+    CROSS_sign_final(&sign_ctx,&sk,&signature);
+    int is_signature_ok = (memcmp(&reference,&signature,sizeof(CROSS_sig_t)) == 0);
+    /* a different chunking verifies the same signature */
+    CROSS_verify_ctx_t verify_ctx;
+    CROSS_verify_init(&verify_ctx);
+    for(int i = 0; i < STREAMING_TEST_MESSAGE_LEN; i += 300){
+        const int chunk_len = (STREAMING_TEST_MESSAGE_LEN-i < 300) ? STREAMING_TEST_MESSAGE_LEN-i : 300;
+        CROSS_verify_update(&verify_ctx,message+i,chunk_len);
+    }
+    is_signature_ok = is_signature_ok &&
+                      CROSS_verify_final(&verify_ctx,&pk,&signature);
+    return is_signature_ok;
+}
+
+int CROSS_workspace_sign_test(){
+    pk_t pk;
+    sk_t sk;
+    CROSS_sig_t reference, signature;
+    char message[8] = "Signme!";
+    CROSS_keygen(&sk,&pk);
+    /* a workspace starting right past an aligned address, which needs the
+     * whole alignment slack */
+    const size_t align = _Alignof(CROSS_sign_workspace_t);
+    const size_t buffer_len = (CROSS_SIGN_WORKSPACE_BYTES+1+align-1)/align*align;
+    uint8_t *buffer = aligned_alloc(align,buffer_len);
+    memset(buffer,0,buffer_len);
+    uint8_t *workspace = buffer+1;
+    CSPRNG_STATE_T rng_checkpoint = platform_csprng_state;
+    CROSS_sign(&sk,message,8,&reference);
+    platform_csprng_state = rng_checkpoint;
+    int is_signature_ok = CROSS_sign_ws(&sk,message,8,&signature,
+                                        workspace,CROSS_SIGN_WORKSPACE_BYTES);
+    is_signature_ok = is_signature_ok &&
+                      (memcmp(&reference,&signature,sizeof(CROSS_sig_t)) == 0);
+    /* no secret material is left in the workspace */
+    uint8_t residual = 0;
+    for(size_t i = 0; i < buffer_len; i++){
+        residual |= buffer[i];
+    }
+    /* a workspace one byte short is rejected, leaving the signature as is */
+    is_signature_ok = is_signature_ok &&
+                      !CROSS_sign_ws(&sk,message,8,&signature,
+                                     workspace,CROSS_SIGN_WORKSPACE_BYTES-1);
+    is_signature_ok = is_signature_ok &&
+                      (memcmp(&reference,&signature,sizeof(CROSS_sig_t)) == 0);
+    free(buffer);
+    return is_signature_ok && (residual == 0);
+}
 
 #define NIST_API_TEST_MESSAGE_LEN 3300
 int CROSS_NIST_API_test(){
@@ -102,6 +362,50 @@ int CROSS_NIST_API_test(){
     return !are_there_problems;
 }
 
+int CROSS_NIST_detached_API_test(){
+    unsigned char pk[CRYPTO_PUBLICKEYBYTES] = {0};
+    unsigned char sk[CRYPTO_SECRETKEYBYTES] = {0};
+
+    unsigned long long mlen = NIST_API_TEST_MESSAGE_LEN;
+    unsigned char message[NIST_API_TEST_MESSAGE_LEN];
+    for (int i=0;i< NIST_API_TEST_MESSAGE_LEN; i++) message[i] = rand();
+
+    unsigned char signature[CRYPTO_BYTES];
+    unsigned long long siglen = 0;
+    /* the message is signed in place at the start of the signed message */
+    unsigned long long smlen = 0;
+    unsigned char signed_message[NIST_API_TEST_MESSAGE_LEN+CRYPTO_BYTES];
+    memcpy(signed_message,message,mlen);
+
+    int are_there_problems = 0;
+    are_there_problems |= crypto_sign_keypair(pk,sk);
+    are_there_problems |= crypto_sign_signature(signature,&siglen,
+                                                message,mlen,
+                                                sk);
+    are_there_problems |= (siglen != CRYPTO_BYTES);
+    are_there_problems |= crypto_sign_verify(signature,siglen,
+                                             message,mlen,
+                                             pk);
+    are_there_problems |= crypto_sign(signed_message,&smlen,
+                                      signed_message,mlen,
+                                      sk);
+    const unsigned char *opened_message = NULL;
+    unsigned long long opened_mlen = 0;
+    are_there_problems |= crypto_sign_open_inplace(&opened_message,
+                                                   &opened_mlen,
+                                                   signed_message,
+                                                   smlen,
+                                                   pk);
+    are_there_problems |= (opened_message != signed_message) ||
+                          (opened_mlen != mlen) ||
+                          (memcmp(opened_message,message,mlen) != 0);
+    /* a detached signature is the tail of a signed message */
+    are_there_problems |= crypto_sign_verify(signed_message+mlen,CRYPTO_BYTES,
+                                             message,mlen,
+                                             pk);
+    return !are_there_problems;
+}
+
 
 int main(int argc, char* argv[]){
     csprng_initialize(&platform_csprng_state,
@@ -119,10 +423,36 @@ int main(int argc, char* argv[]){
         fprintf(stderr,"Restr %d\n",iteration_ok);
         iteration_ok = iteration_ok && signature_invariant_test();
         fprintf(stderr,"Sig_invariant %d\n",iteration_ok);
+#if defined(PAR_HASH_WAYS)
+        iteration_ok = iteration_ok && fp_mat_by_fp_matrix_batch_test();
+        fprintf(stderr,"Batch_syndrome %d\n",iteration_ok);
+        iteration_ok = iteration_ok && restr_diff_by_fp_vec_pointwise_test();
+        fprintf(stderr,"Fused_round %d\n",iteration_ok);
+#endif
         iteration_ok = iteration_ok && CROSS_sign_verify_test();
         fprintf(stderr,"Full %d\n",iteration_ok);
+        iteration_ok = iteration_ok && CROSS_expanded_pk_verify_test();
+        fprintf(stderr,"Expanded pk %d\n",iteration_ok);
+        iteration_ok = iteration_ok && CROSS_verify_batch_test();
+        fprintf(stderr,"Verify batch %d\n",iteration_ok);
+        iteration_ok = iteration_ok && CROSS_sign_batch_test();
+        fprintf(stderr,"Sign batch %d\n",iteration_ok);
+        iteration_ok = iteration_ok && CROSS_expanded_sk_sign_test();
+        fprintf(stderr,"Expanded sk %d\n",iteration_ok);
+#if !defined(LOW_MEMORY_SIGN)
+        iteration_ok = iteration_ok && CROSS_threaded_sign_test();
+        fprintf(stderr,"Threaded sign %d\n",iteration_ok);
+#endif
+        iteration_ok = iteration_ok && CROSS_threaded_verify_test();
+        fprintf(stderr,"Threaded verify %d\n",iteration_ok);
+        iteration_ok = iteration_ok && CROSS_streaming_test();
+        fprintf(stderr,"Streaming %d\n",iteration_ok);
+        iteration_ok = iteration_ok && CROSS_workspace_sign_test();
+        fprintf(stderr,"Workspace sign %d\n",iteration_ok);
         iteration_ok = iteration_ok && CROSS_NIST_API_test();
         fprintf(stderr,"NIST API %d\n",iteration_ok);
+        iteration_ok = iteration_ok && CROSS_NIST_detached_API_test();
+        fprintf(stderr,"NIST detached API %d\n",iteration_ok);
         tests_ok += iteration_ok;
     }
     fprintf(stderr,"\n%d tests functional out of %d\n",tests_ok,NUM_TEST_ITERATIONS);
@@ -1,4 +1,5 @@
-/* File imported from XKCP for use in CROSS, without modifications. */
+/* File imported from XKCP for use in CROSS, with the addition of the
+ * AddLanesSeparate/ExtractLanesSeparate functions. */
 /*
 The Keccak-p permutations, designed by Guido Bertoni, Joan Daemen, Michaël Peeters and Gilles Van Assche.
 
@@ -43,6 +44,8 @@ void KeccakP1600times4_InitializeAll(KeccakP1600times4_states *states);
     ((unsigned char*)(states))[(instanceIndex)*8 + ((offset)/8)*4*8 + (offset)%8] ^= (byte)
 void KeccakP1600times4_AddBytes(KeccakP1600times4_states *states, unsigned int instanceIndex, const unsigned char *data, unsigned int offset, unsigned int length);
 void KeccakP1600times4_AddLanesAll(KeccakP1600times4_states *states, const unsigned char *data, unsigned int laneCount, unsigned int laneOffset);
+/* as AddLanesAll, with the input of each instance in a separate buffer */
+void KeccakP1600times4_AddLanesSeparate(KeccakP1600times4_states *states, const unsigned char *data0, const unsigned char *data1, const unsigned char *data2, const unsigned char *data3, unsigned int laneCount);
 void KeccakP1600times4_OverwriteBytes(KeccakP1600times4_states *states, unsigned int instanceIndex, const unsigned char *data, unsigned int offset, unsigned int length);
 void KeccakP1600times4_OverwriteLanesAll(KeccakP1600times4_states *states, const unsigned char *data, unsigned int laneCount, unsigned int laneOffset);
 void KeccakP1600times4_OverwriteWithZeroes(KeccakP1600times4_states *states, unsigned int instanceIndex, unsigned int byteCount);
@@ -52,6 +55,8 @@ void KeccakP1600times4_PermuteAll_12rounds(KeccakP1600times4_states *states);
 void KeccakP1600times4_PermuteAll_24rounds(KeccakP1600times4_states *states);
 void KeccakP1600times4_ExtractBytes(const KeccakP1600times4_states *states, unsigned int instanceIndex, unsigned char *data, unsigned int offset, unsigned int length);
 void KeccakP1600times4_ExtractLanesAll(const KeccakP1600times4_states *states, unsigned char *data, unsigned int laneCount, unsigned int laneOffset);
+/* as ExtractLanesAll, with the output of each instance in a separate buffer */
+void KeccakP1600times4_ExtractLanesSeparate(const KeccakP1600times4_states *states, unsigned char *data0, unsigned char *data1, unsigned char *data2, unsigned char *data3, unsigned int laneCount);
 void KeccakP1600times4_ExtractAndAddBytes(const KeccakP1600times4_states *states, unsigned int instanceIndex,  const unsigned char *input, unsigned char *output, unsigned int offset, unsigned int length);
 void KeccakP1600times4_ExtractAndAddLanesAll(const KeccakP1600times4_states *states, const unsigned char *input, unsigned char *output, unsigned int laneCount, unsigned int laneOffset);
 size_t KeccakF1600times4_FastLoop_Absorb(KeccakP1600times4_states *states, unsigned int laneCount, unsigned int laneOffsetParallel, unsigned int laneOffsetSerial, const unsigned char *data, size_t dataByteLen);
@@ -0,0 +1,59 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.2 (July 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Abstract:
+ *
+ * Keccak-p[1600] permutation computed on eight independent states in
+ * parallel, one per 64-bit element of the AVX-512 registers.
+ * The API mirrors the one of KeccakP-1600-times4-SnP.h: the bytes of the
+ * state of an instance are addressed through the instance index, while the
+ * lane-wise functions take a separate buffer for each instance.
+ *
+ **/
+
+#pragma once
+
+#include <stdint.h>
+#include <immintrin.h>
+
+#define KECCAK_X8_INSTANCES 8
+
+typedef struct {
+    /* lane i of instance k is the k-th 64-bit element of A[i] */
+    __m512i A[25];
+} KeccakP1600times8_states;
+
+void KeccakP1600times8_InitializeAll(KeccakP1600times8_states *states);
+void KeccakP1600times8_AddBytes(KeccakP1600times8_states *states, unsigned int instanceIndex, const unsigned char *data, unsigned int offset, unsigned int length);
+/* a NULL data pointer leaves the state of the corresponding instance untouched */
+void KeccakP1600times8_AddLanesSeparate(KeccakP1600times8_states *states, const unsigned char *const data[KECCAK_X8_INSTANCES], unsigned int laneCount);
+void KeccakP1600times8_PermuteAll_24rounds(KeccakP1600times8_states *states);
+void KeccakP1600times8_ExtractBytes(const KeccakP1600times8_states *states, unsigned int instanceIndex, unsigned char *data, unsigned int offset, unsigned int length);
+/* a NULL data pointer skips the extraction for the corresponding instance */
+void KeccakP1600times8_ExtractLanesSeparate(const KeccakP1600times8_states *states, unsigned char *const data[KECCAK_X8_INSTANCES], unsigned int laneCount);
@@ -59,6 +59,25 @@
 #include <pmmintrin.h>
 #endif
 
+/* Set of GCC/LLVM macros set by the -march=skylake-avx512 and more recent
+ * CPUs, enabling the 8-way parallel Keccak-p[1600]. The 4-way AVX2 one is
+ * employed in their absence */
+#if defined(HIGH_PERFORMANCE_X86_64) && \
+    defined(__AVX512F__) && defined(__AVX512VL__)
+
+#define HIGH_PERFORMANCE_X86_64_AVX512
+#endif
+
+/* Byte and word granularity AVX-512 instructions, enabling the 512-bit
+ * matrix-vector products, which load the row tails through a mask */
+#if defined(HIGH_PERFORMANCE_X86_64_AVX512) && defined(__AVX512BW__)
+#define HIGH_PERFORMANCE_X86_64_AVX512BW
+#endif
+
 #define EPI8_PER_REG 32
 #define EPI16_PER_REG 16
 #define EPI32_PER_REG 8
+
+#define EPI8_PER_ZMM 64
+#define EPI16_PER_ZMM 32
+#define EPI32_PER_ZMM 16
@@ -34,6 +34,8 @@
 #ifndef CSPRNG_HASH_H
 #define CSPRNG_HASH_H
 
+#include <stddef.h>
+
 #include "parameters.h"
 #include "sha3.h"
 
@@ -67,7 +69,9 @@ void csprng_randombytes(unsigned char * const x,
 /*************** Parallel CSPRNG (x2, x3, x4) ********************/
 
 #define CSPRNG_X2_STATE_T SHAKE_X2_STATE_STRUCT
-/* CRSPRNG_x3 calls SHAKE_x4 and discards the fourth input/output */
+/* CSPRNG_x3 runs on SHAKE_x4, with the fourth instance mirroring the third
+ * one: the fourth lane costs nothing in the vectorized permutation, and no
+ * scratch input or output buffer is needed */
 #define CSPRNG_X3_STATE_T SHAKE_X4_STATE_STRUCT
 #define CSPRNG_X4_STATE_T SHAKE_X4_STATE_STRUCT
 
@@ -98,17 +102,16 @@ void csprng_initialize_x3(CSPRNG_X3_STATE_T * const csprng_state,
                           const uint16_t dsc1,
                           const uint16_t dsc2,
                           const uint16_t dsc3) {
-   const unsigned char seed4[seed_len_bytes]; // discarded
    xof_shake_x4_init(csprng_state);
-   xof_shake_x4_update(csprng_state,seed1,seed2,seed3,seed4,seed_len_bytes);
-   uint8_t dsc_ordered1[2], dsc_ordered2[2], dsc_ordered3[2], dsc_ordered4[2]; // dsc_ordered4 is discarded
+   xof_shake_x4_update(csprng_state,seed1,seed2,seed3,seed3,seed_len_bytes);
+   uint8_t dsc_ordered1[2], dsc_ordered2[2], dsc_ordered3[2];
    dsc_ordered1[0] = dsc1 & 0xff;
    dsc_ordered1[1] = (dsc1 >> 8) & 0xff;
    dsc_ordered2[0] = dsc2 & 0xff;
    dsc_ordered2[1] = (dsc2 >> 8) & 0xff;
    dsc_ordered3[0] = dsc3 & 0xff;
    dsc_ordered3[1] = (dsc3 >> 8) & 0xff;
-   xof_shake_x4_update(csprng_state,dsc_ordered1,dsc_ordered2,dsc_ordered3,dsc_ordered4,2);
+   xof_shake_x4_update(csprng_state,dsc_ordered1,dsc_ordered2,dsc_ordered3,dsc_ordered3,2);
    xof_shake_x4_final(csprng_state);
 }
 static inline
@@ -143,8 +146,8 @@ void csprng_randombytes_x2(unsigned char * const x1, unsigned char * const x2, u
 }
 static inline
 void csprng_randombytes_x3(unsigned char * const x1,unsigned char * const x2,unsigned char * const x3,uint64_t xlen,CSPRNG_X3_STATE_T * const csprng_state){
-   unsigned char x4[xlen]; // discarded
-   xof_shake_x4_extract(csprng_state,x1,x2,x3,x4,xlen);
+   /* the fourth instance yields the same bytes as the third one */
+   xof_shake_x4_extract(csprng_state,x1,x2,x3,x3,xlen);
 }
 static inline
 void csprng_randombytes_x4(unsigned char * const x1,unsigned char * const x2,unsigned char * const x3,unsigned char * const x4,uint64_t xlen,CSPRNG_X4_STATE_T * const csprng_state){
@@ -187,22 +190,53 @@ void randombytes(unsigned char * x,
 
 /************************* HASH functions ********************************/
 
+/* Incremental hashing, for inputs which are not available at once: the
+ * digest of a sequence of hash_update calls matches the one computed by
+ * hash on their concatenation */
+static inline
+void hash_init(CSPRNG_STATE_T * const hash_state){
+   /* SHAKE with a 2*lambda bit digest is employed also for hashing */
+   xof_shake_init(hash_state, SEED_LENGTH_BYTES*8);
+}
+
+/* the SHAKE wrappers take 32 bit lengths, longer inputs are absorbed in
+ * chunks */
+#define HASH_UPDATE_MAX_CHUNK_BYTES (1UL << 30)
+
+static inline
+void hash_update(CSPRNG_STATE_T * const hash_state,
+                 const unsigned char *m,
+                 uint64_t mlen){
+   while(mlen > HASH_UPDATE_MAX_CHUNK_BYTES){
+      xof_shake_update(hash_state,m,HASH_UPDATE_MAX_CHUNK_BYTES);
+      m += HASH_UPDATE_MAX_CHUNK_BYTES;
+      mlen -= HASH_UPDATE_MAX_CHUNK_BYTES;
+   }
+   xof_shake_update(hash_state,m,mlen);
+}
+
+static inline
+void hash_final(uint8_t digest[HASH_DIGEST_LENGTH],
+                CSPRNG_STATE_T * const hash_state,
+                const uint16_t dsc){
+   uint8_t dsc_ordered[2];
+   dsc_ordered[0] = dsc & 0xff;
+   dsc_ordered[1] = (dsc >> 8) & 0xff;
+   xof_shake_update(hash_state,dsc_ordered,2);
+   xof_shake_final(hash_state);
+   xof_shake_extract(hash_state,digest,HASH_DIGEST_LENGTH);
+}
+
 /* Opaque algorithm agnostic hash call */
 static inline
 void hash(uint8_t digest[HASH_DIGEST_LENGTH],
           const unsigned char *const m,
           const uint64_t mlen,
           const uint16_t dsc){
-   /* SHAKE with a 2*lambda bit digest is employed also for hashing */
-   CSPRNG_STATE_T csprng_state;    
-   xof_shake_init(&csprng_state, SEED_LENGTH_BYTES*8);
-   xof_shake_update(&csprng_state,m,mlen);
-   uint8_t dsc_ordered[2];
-   dsc_ordered[0] = dsc & 0xff;
-   dsc_ordered[1] = (dsc >> 8) & 0xff;
-   xof_shake_update(&csprng_state,dsc_ordered,2);
-   xof_shake_final(&csprng_state);    
-   xof_shake_extract(&csprng_state,digest,HASH_DIGEST_LENGTH);
+   CSPRNG_STATE_T csprng_state;
+   hash_init(&csprng_state);
+   hash_update(&csprng_state,m,mlen);
+   hash_final(digest,&csprng_state,dsc);
 }
 
 #define par_xof_input csprng_initialize_par
@@ -228,6 +262,94 @@ void hash_par(int par_level,
    par_xof_output(par_level, &states, digest_1, digest_2, digest_3, digest_4, HASH_DIGEST_LENGTH);
 }
 
+/*************** Common API for 8-way Parallel CSPRNG and hash ***************/
+
+/* Up to PAR_HASH_WAYS instances, passed as arrays, the first par_level being
+ * in use. With AVX-512, more than four instances are computed by the 8-way
+ * Keccak; otherwise PAR_HASH_WAYS is 4 and the calls map onto the 4-way API */
+#if defined(HIGH_PERFORMANCE_X86_64_AVX512)
+#define PAR_HASH_WAYS 8
+typedef struct {
+   PAR_CSPRNG_STATE_T states4;
+   SHAKE_X8_STATE_STRUCT state8;
+} par8_shake_ctx;
+#else
+#define PAR_HASH_WAYS 4
+typedef struct {
+   PAR_CSPRNG_STATE_T states4;
+} par8_shake_ctx;
+#endif
+#define PAR8_CSPRNG_STATE_T par8_shake_ctx
+
+static inline
+void csprng_initialize_par8(int par_level,
+                            PAR8_CSPRNG_STATE_T * const states,
+                            const unsigned char * const seed[],
+                            const uint32_t seed_len_bytes,
+                            const uint16_t dsc[]) {
+#if defined(HIGH_PERFORMANCE_X86_64_AVX512)
+   if(par_level <= 4) {
+      csprng_initialize_par(par_level, &(states->states4),
+                            seed[0], seed[1], seed[2], seed[3], seed_len_bytes,
+                            dsc[0], dsc[1], dsc[2], dsc[3]);
+      return;
+   }
+   const unsigned char *in[8];
+   uint8_t dsc_ordered[8][2];
+   for(int i = 0; i < 8; i++) {
+      in[i] = (i < par_level) ? seed[i] : NULL;
+   }
+   xof_shake_x8_init(&(states->state8));
+   xof_shake_x8_update(&(states->state8), in, seed_len_bytes);
+   for(int i = 0; i < 8; i++) {
+      if(i < par_level) {
+         dsc_ordered[i][0] = dsc[i] & 0xff;
+         dsc_ordered[i][1] = (dsc[i] >> 8) & 0xff;
+         in[i] = dsc_ordered[i];
+      }
+   }
+   xof_shake_x8_update(&(states->state8), in, 2);
+   xof_shake_x8_final(&(states->state8));
+#else
+   csprng_initialize_par(par_level, &(states->states4),
+                         seed[0], seed[1], seed[2], seed[3], seed_len_bytes,
+                         dsc[0], dsc[1], dsc[2], dsc[3]);
+#endif
+}
+
+static inline
+void csprng_randombytes_par8(int par_level,
+                             PAR8_CSPRNG_STATE_T * const states,
+                             unsigned char * const x[],
+                             uint64_t xlen) {
+#if defined(HIGH_PERFORMANCE_X86_64_AVX512)
+   if(par_level <= 4) {
+      csprng_randombytes_par(par_level, &(states->states4),
+                             x[0], x[1], x[2], x[3], xlen);
+      return;
+   }
+   unsigned char *out[8];
+   for(int i = 0; i < 8; i++) {
+      out[i] = (i < par_level) ? x[i] : NULL;
+   }
+   xof_shake_x8_extract(&(states->state8), out, xlen);
+#else
+   csprng_randombytes_par(par_level, &(states->states4),
+                          x[0], x[1], x[2], x[3], xlen);
+#endif
+}
+
+static inline
+void hash_par8(int par_level,
+               uint8_t * const digest[],
+               const unsigned char * const m[],
+               const uint64_t mlen,
+               const uint16_t dsc[]) {
+   PAR8_CSPRNG_STATE_T states;
+   csprng_initialize_par8(par_level, &states, m, mlen, dsc);
+   csprng_randombytes_par8(par_level, &states, digest, HASH_DIGEST_LENGTH);
+}
+
 /***************** Specialized CSPRNGs for non binary domains *****************/
 
 /* CSPRNG sampling fixed weight strings */
@@ -237,17 +359,18 @@ void expand_digest_to_fixed_weight(uint8_t fixed_weight_string[T],
 #define BITS_FOR_P BITS_TO_REPRESENT(P-1) 
 #define BITS_FOR_Z BITS_TO_REPRESENT(Z-1) 
 
+#define CSPRNG_FP_VEC_BYTES (ROUND_UP(BITS_N_FP_CT_RNG,8)/8)
+
+/* rejection sampling of a fp_vec out of CSPRNG_FP_VEC_BYTES CSPRNG output bytes */
 static inline
-void csprng_fp_vec(FP_ELEM res[N],
-                   CSPRNG_STATE_T * const csprng_state){
+void fp_vec_from_csprng_bytes(FP_ELEM res[N],
+                   const uint8_t CSPRNG_buffer[CSPRNG_FP_VEC_BYTES]){
     const FP_ELEM mask = ( (FP_ELEM) 1 << BITS_FOR_P) - 1;
-    uint8_t CSPRNG_buffer[ROUND_UP(BITS_N_FP_CT_RNG,8)/8];
     /* To facilitate hardware implementations, the uint64_t 
      * sub-buffer is consumed starting from the least significant byte 
      * i.e., from the first being output by SHAKE. Bits in the byte are 
      * discarded shifting them out to the right, shifting fresh ones
      * in from the left end */
-    csprng_randombytes(CSPRNG_buffer,sizeof(CSPRNG_buffer),csprng_state);    
     int placed = 0;
     uint64_t sub_buffer = 0;
     for (int i=0; i<8; i++) {
@@ -256,7 +379,7 @@ void csprng_fp_vec(FP_ELEM res[N],
     /* position of the next fresh byte in CSPRNG_buffer*/
     int bits_in_sub_buf = 64;
     int pos_in_buf = 8;
-    int pos_remaining = sizeof(CSPRNG_buffer) - pos_in_buf;
+    int pos_remaining = CSPRNG_FP_VEC_BYTES - pos_in_buf;
     while(placed < N) {
         if (bits_in_sub_buf <= 32 && pos_remaining > 0) {
             /* get at most 4 bytes from buffer */
@@ -279,19 +402,44 @@ void csprng_fp_vec(FP_ELEM res[N],
     }
 }
 
+static inline
+void csprng_fp_vec(FP_ELEM res[N],
+                   CSPRNG_STATE_T * const csprng_state){
+    uint8_t CSPRNG_buffer[CSPRNG_FP_VEC_BYTES];
+    csprng_randombytes(CSPRNG_buffer,sizeof(CSPRNG_buffer),csprng_state);
+    fp_vec_from_csprng_bytes(res, CSPRNG_buffer);
+}
+
+/* samples par_level fp_vecs, one from each of the parallel CSPRNG states */
+static inline
+void csprng_fp_vec_par8(int par_level,
+                   FP_ELEM * const res[],
+                   PAR8_CSPRNG_STATE_T * const states){
+    uint8_t CSPRNG_buffer[PAR_HASH_WAYS][CSPRNG_FP_VEC_BYTES];
+    unsigned char *buffers[PAR_HASH_WAYS];
+    for (int i=0; i<PAR_HASH_WAYS; i++) {
+        buffers[i] = CSPRNG_buffer[i];
+    }
+    csprng_randombytes_par8(par_level, states, buffers, CSPRNG_FP_VEC_BYTES);
+    for (int i=0; i<par_level; i++) {
+        fp_vec_from_csprng_bytes(res[i], CSPRNG_buffer[i]);
+    }
+}
+
 #define BITS_FOR_P_M_ONE BITS_TO_REPRESENT(P-2) 
 
+#define CSPRNG_FP_VEC_CHALL_1_BYTES (ROUND_UP(BITS_CHALL_1_FPSTAR_CT_RNG,8)/8)
+
+/* rejection sampling of the first challenge out of CSPRNG_FP_VEC_CHALL_1_BYTES CSPRNG output bytes */
 static inline
-void csprng_fp_vec_chall_1(FP_ELEM res[T],
-                   CSPRNG_STATE_T * const csprng_state){
+void fp_vec_chall_1_from_csprng_bytes(FP_ELEM res[T],
+                   const uint8_t CSPRNG_buffer[CSPRNG_FP_VEC_CHALL_1_BYTES]){
     const FP_ELEM mask = ( (FP_ELEM) 1 << BITS_FOR_P_M_ONE) - 1;
-    uint8_t CSPRNG_buffer[ROUND_UP(BITS_CHALL_1_FPSTAR_CT_RNG,8)/8];
     /* To facilitate hardware implementations, the uint64_t 
      * sub-buffer is consumed starting from the least significant byte 
      * i.e., from the first being output by SHAKE. Bits in the byte are 
      * discarded shifting them out to the right , shifting fresh ones
      * in from the left end */
-    csprng_randombytes(CSPRNG_buffer,sizeof(CSPRNG_buffer),csprng_state);    
     int placed = 0;
     uint64_t sub_buffer = 0;
     for (int i=0; i<8; i++) {
@@ -300,7 +448,7 @@ void csprng_fp_vec_chall_1(FP_ELEM res[T],
     /* position of the next fresh byte in CSPRNG_buffer*/
     int bits_in_sub_buf = 64;
     int pos_in_buf = 8;
-    int pos_remaining = sizeof(CSPRNG_buffer) - pos_in_buf;
+    int pos_remaining = CSPRNG_FP_VEC_CHALL_1_BYTES - pos_in_buf;
     while(placed < T) {
         if (bits_in_sub_buf <= 32 && pos_remaining > 0) {
             /* get at most 4 bytes from buffer */
@@ -324,6 +472,30 @@ void csprng_fp_vec_chall_1(FP_ELEM res[T],
     }
 }
 
+static inline
+void csprng_fp_vec_chall_1(FP_ELEM res[T],
+                   CSPRNG_STATE_T * const csprng_state){
+    uint8_t CSPRNG_buffer[CSPRNG_FP_VEC_CHALL_1_BYTES];
+    csprng_randombytes(CSPRNG_buffer,sizeof(CSPRNG_buffer),csprng_state);
+    fp_vec_chall_1_from_csprng_bytes(res, CSPRNG_buffer);
+}
+
+/* samples par_level first challenges, one from each of the parallel CSPRNG states */
+static inline
+void csprng_fp_vec_chall_1_par8(int par_level,
+                   FP_ELEM * const res[],
+                   PAR8_CSPRNG_STATE_T * const states){
+    uint8_t CSPRNG_buffer[PAR_HASH_WAYS][CSPRNG_FP_VEC_CHALL_1_BYTES];
+    unsigned char *buffers[PAR_HASH_WAYS];
+    for (int i=0; i<PAR_HASH_WAYS; i++) {
+        buffers[i] = CSPRNG_buffer[i];
+    }
+    csprng_randombytes_par8(par_level, states, buffers, CSPRNG_FP_VEC_CHALL_1_BYTES);
+    for (int i=0; i<par_level; i++) {
+        fp_vec_chall_1_from_csprng_bytes(res[i], CSPRNG_buffer[i]);
+    }
+}
+
 static inline
 void csprng_fp_mat(FP_ELEM res[K][N-K],
                    CSPRNG_STATE_T * const csprng_state){
@@ -367,17 +539,18 @@ void csprng_fp_mat(FP_ELEM res[K][N-K],
 }
 
 #if defined(RSDP)
+#define CSPRNG_FZ_VEC_BYTES (ROUND_UP(BITS_N_FZ_CT_RNG,8)/8)
+
+/* rejection sampling of a fz_vec out of CSPRNG_FZ_VEC_BYTES CSPRNG output bytes */
 static inline
-void csprng_fz_vec(FZ_ELEM res[N],
-                   CSPRNG_STATE_T * const csprng_state){
+void fz_vec_from_csprng_bytes(FZ_ELEM res[N],
+                   const uint8_t CSPRNG_buffer[CSPRNG_FZ_VEC_BYTES]){
     const FZ_ELEM mask = ( (FZ_ELEM) 1 << BITS_TO_REPRESENT(Z-1)) - 1;
-    uint8_t CSPRNG_buffer[ROUND_UP(BITS_N_FZ_CT_RNG,8)/8];
     /* To facilitate hardware implementations, the uint64_t 
      * sub-buffer is consumed starting from the least significant byte 
      * i.e., from the first being output by SHAKE. Bits in the byte are 
      * discarded shifting them out to the right , shifting fresh ones
      * in from the left end */
-    csprng_randombytes(CSPRNG_buffer,sizeof(CSPRNG_buffer),csprng_state);    
     int placed = 0;
     uint64_t sub_buffer = 0;
     for (int i=0; i<8; i++) {
@@ -386,7 +559,7 @@ void csprng_fz_vec(FZ_ELEM res[N],
 	/* position of the next fresh byte in CSPRNG_buffer*/
     int bits_in_sub_buf = 64;
     int pos_in_buf = 8;
-    int pos_remaining = sizeof(CSPRNG_buffer) - pos_in_buf;
+    int pos_remaining = CSPRNG_FZ_VEC_BYTES - pos_in_buf;
     while(placed < N) {
         if (bits_in_sub_buf <= 32 && pos_remaining > 0) {
             /* get at most 4 bytes from buffer */
@@ -408,18 +581,43 @@ void csprng_fz_vec(FZ_ELEM res[N],
         bits_in_sub_buf -= BITS_FOR_Z;
     }
 }
-#elif defined(RSDPG)
+
 static inline
-void csprng_fz_inf_w(FZ_ELEM res[M],
+void csprng_fz_vec(FZ_ELEM res[N],
                    CSPRNG_STATE_T * const csprng_state){
+    uint8_t CSPRNG_buffer[CSPRNG_FZ_VEC_BYTES];
+    csprng_randombytes(CSPRNG_buffer,sizeof(CSPRNG_buffer),csprng_state);
+    fz_vec_from_csprng_bytes(res, CSPRNG_buffer);
+}
+
+/* samples par_level fz_vecs, one from each of the parallel CSPRNG states */
+static inline
+void csprng_fz_vec_par8(int par_level,
+                   FZ_ELEM * const res[],
+                   PAR8_CSPRNG_STATE_T * const states){
+    uint8_t CSPRNG_buffer[PAR_HASH_WAYS][CSPRNG_FZ_VEC_BYTES];
+    unsigned char *buffers[PAR_HASH_WAYS];
+    for (int i=0; i<PAR_HASH_WAYS; i++) {
+        buffers[i] = CSPRNG_buffer[i];
+    }
+    csprng_randombytes_par8(par_level, states, buffers, CSPRNG_FZ_VEC_BYTES);
+    for (int i=0; i<par_level; i++) {
+        fz_vec_from_csprng_bytes(res[i], CSPRNG_buffer[i]);
+    }
+}
+#elif defined(RSDPG)
+#define CSPRNG_FZ_INF_W_BYTES (ROUND_UP(BITS_M_FZ_CT_RNG,8)/8)
+
+/* rejection sampling of a fz_inf_w out of CSPRNG_FZ_INF_W_BYTES CSPRNG output bytes */
+static inline
+void fz_inf_w_from_csprng_bytes(FZ_ELEM res[M],
+                   const uint8_t CSPRNG_buffer[CSPRNG_FZ_INF_W_BYTES]){
     const FZ_ELEM mask = ( (FZ_ELEM) 1 << BITS_TO_REPRESENT(Z-1)) - 1;
-    uint8_t CSPRNG_buffer[ROUND_UP(BITS_M_FZ_CT_RNG,8)/8];
     /* To facilitate hardware implementations, the uint64_t 
      * sub-buffer is consumed starting from the least significant byte 
      * i.e., from the first being output by SHAKE. Bits in the byte are 
      * discarded shifting them out to the right , shifting fresh ones
      * in from the left end */
-    csprng_randombytes(CSPRNG_buffer,sizeof(CSPRNG_buffer),csprng_state);    
     int placed = 0;
     uint64_t sub_buffer = 0;
     for (int i=0; i<8; i++) {
@@ -428,7 +626,7 @@ void csprng_fz_inf_w(FZ_ELEM res[M],
 	/* position of the next fresh byte in CSPRNG_buffer*/
     int bits_in_sub_buf = 64;
     int pos_in_buf = 8;
-    int pos_remaining = sizeof(CSPRNG_buffer) - pos_in_buf;
+    int pos_remaining = CSPRNG_FZ_INF_W_BYTES - pos_in_buf;
     while(placed < M) {
         if (bits_in_sub_buf <= 32 && pos_remaining > 0) {
             /* get at most 4 bytes from buffer */
@@ -451,6 +649,30 @@ void csprng_fz_inf_w(FZ_ELEM res[M],
     }
 }
 
+static inline
+void csprng_fz_inf_w(FZ_ELEM res[M],
+                   CSPRNG_STATE_T * const csprng_state){
+    uint8_t CSPRNG_buffer[CSPRNG_FZ_INF_W_BYTES];
+    csprng_randombytes(CSPRNG_buffer,sizeof(CSPRNG_buffer),csprng_state);
+    fz_inf_w_from_csprng_bytes(res, CSPRNG_buffer);
+}
+
+/* samples par_level fz_inf_ws, one from each of the parallel CSPRNG states */
+static inline
+void csprng_fz_inf_w_par8(int par_level,
+                   FZ_ELEM * const res[],
+                   PAR8_CSPRNG_STATE_T * const states){
+    uint8_t CSPRNG_buffer[PAR_HASH_WAYS][CSPRNG_FZ_INF_W_BYTES];
+    unsigned char *buffers[PAR_HASH_WAYS];
+    for (int i=0; i<PAR_HASH_WAYS; i++) {
+        buffers[i] = CSPRNG_buffer[i];
+    }
+    csprng_randombytes_par8(par_level, states, buffers, CSPRNG_FZ_INF_W_BYTES);
+    for (int i=0; i<par_level; i++) {
+        fz_inf_w_from_csprng_bytes(res[i], CSPRNG_buffer[i]);
+    }
+}
+
 static inline
 void csprng_fz_mat(FZ_ELEM res[M][N-M],
                    CSPRNG_STATE_T * const csprng_state){
@@ -0,0 +1,61 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.2 (July 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Abstract:
+ *
+ * Implementation of Keccak-p[1600] in parallel (x2) mode, with the same
+ * init -> absorb* -> finalize -> squeeze* API of the x4 mode.
+ *
+ **/
+
+#pragma once
+
+/* SHAKE rates, domain separator and lane size are shared with the x4 mode */
+#include "fips202x4.h"
+#include "KeccakP-1600-times2-SnP.h"
+
+typedef struct {
+    KeccakP1600times2_states state;
+    /* - during absorption: number of absorbed bytes already xored into the state, not yet permuted
+     * - during squeezing: number of not-yet-squeezed bytes */
+    uint64_t offset;
+} par2_keccak_context;
+
+void keccak_x2_init(par2_keccak_context *ctx);
+void keccak_x2_absorb(
+    par2_keccak_context *ctx,
+    const unsigned char *in1,
+    const unsigned char *in2,
+    unsigned int in_len);
+void keccak_x2_finalize(par2_keccak_context *ctx);
+void keccak_x2_squeeze(
+    par2_keccak_context *ctx,
+    unsigned char *out1,
+    unsigned char *out2,
+    unsigned int out_len);
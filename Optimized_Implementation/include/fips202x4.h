@@ -41,6 +41,8 @@
  * 
  */
 
+#pragma once
+
 #include "KeccakP-1600-times4-SnP.h"
 
 /************************************************
@@ -0,0 +1,62 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.2 (July 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Abstract:
+ *
+ * Implementation of Keccak-p[1600] in parallel (x8) mode, with the same
+ * init -> absorb* -> finalize -> squeeze* API of the x4 mode.
+ * The inputs and outputs of the eight instances are passed as arrays of
+ * pointers; NULL pointers mark instances which are not in use, their
+ * inputs are not absorbed and their outputs are not extracted.
+ *
+ **/
+
+#pragma once
+
+/* SHAKE rates, domain separator and lane size are shared with the x4 mode */
+#include "fips202x4.h"
+#include "KeccakP-1600-times8-SnP.h"
+
+typedef struct {
+    KeccakP1600times8_states state;
+    /* - during absorption: number of absorbed bytes already xored into the state, not yet permuted
+     * - during squeezing: number of not-yet-squeezed bytes */
+    uint64_t offset;
+} par8_keccak_context;
+
+void keccak_x8_init(par8_keccak_context *ctx);
+void keccak_x8_absorb(
+    par8_keccak_context *ctx,
+    const unsigned char *const in[KECCAK_X8_INSTANCES],
+    unsigned int in_len);
+void keccak_x8_finalize(par8_keccak_context *ctx);
+void keccak_x8_squeeze(
+    par8_keccak_context *ctx,
+    unsigned char *const out[KECCAK_X8_INSTANCES],
+    unsigned int out_len);
@@ -74,8 +74,31 @@
 
 #define FP_ELEM_CMOV(BIT,TRUE_V,FALSE_V)  ( (((FP_ELEM)0 - (BIT)) & (TRUE_V)) | (~((FP_ELEM)0 - (BIT)) & (FALSE_V)) )
 
+#if defined(RESTR_TO_VAL_TABLE)
+/* g^x is computed as g^(x mod 4) * g^(4*((x >> 2) mod 4)) * g^(16*(x >> 4)),
+ * the factors being read from tables of 16-bit entries packed in 64-bit
+ * words, indexed by shifts as RESTR_G_TABLE is for RSDP. The eight values of
+ * g^(16*i) span two words, selected with a mask. The product of the three
+ * factors is below 2^27, thus a single reduction is required */
+#define RESTR_G_TABLE_0     ((uint64_t) 0x0018010000100001)
+#define RESTR_G_TABLE_1     ((uint64_t) 0x01A1016301800001)
+#define RESTR_G_TABLE_2_LO  ((uint64_t) 0x005B005D012E0001)
+#define RESTR_G_TABLE_2_HI  ((uint64_t) 0x00910089013F01F9)
+
+static inline
+FP_ELEM RESTR_TO_VAL(FP_ELEM x){
+    uint64_t hi_mask = (uint64_t)0 - ((x >> 6) & 1);
+    uint64_t table_2 = (RESTR_G_TABLE_2_LO & ~hi_mask) |
+                       (RESTR_G_TABLE_2_HI & hi_mask);
+    uint32_t res0 = (uint16_t) (RESTR_G_TABLE_0 >> (16*(x & 3)));
+    uint32_t res1 = (uint16_t) (RESTR_G_TABLE_1 >> (16*((x >> 2) & 3)));
+    uint32_t res2 = (uint16_t) (table_2 >> (16*((x >> 4) & 3)));
+    return FPRED_SINGLE(res0 * res1 * res2);
+}
+#else
 /* log reduction, constant time unrolled S&M w/precomputed squares.
- * To be further optimized with muxed register-fitting tables */
+ * Compile with RESTR_TO_VAL_TABLE defined to employ the register-fitting
+ * tables above instead */
 static inline
 FP_ELEM RESTR_TO_VAL(FP_ELEM x){
     uint32_t res1, res2, res3, res4;
@@ -92,6 +115,7 @@ FP_ELEM RESTR_TO_VAL(FP_ELEM x){
      *     RESTR_G_GEN_16*RESTR_G_GEN_32*RESTR_G_GEN_64               < 2^32 */
     return FPRED_SINGLE( FPRED_SINGLE(res1 * res2) * FPRED_SINGLE(res3 * res4) );
 }
+#endif /* defined(RESTR_TO_VAL_TABLE) */
 
 #endif
 
@@ -117,6 +141,26 @@ static inline __m256i mm256_mod509_epu32(__m256i a){
     return r;
 }
 
+#if defined(HIGH_PERFORMANCE_X86_64_AVX512BW)
+/* reduce modulo 509 sixteen 32-bit integers packed into a 512-bit vector,
+ * as mm256_mod509_epu32 */
+static inline __m512i mm512_mod509_epu32(__m512i a){
+    int b_shift = 18; // ceil(log2(509))*2
+    int b_mul = (((uint64_t)1U << b_shift) / P);
+    /* r = a - ((B_MUL * a) >> B_SHIFT) * P) */
+    __m512i b_mul_32 = _mm512_set1_epi32(b_mul);
+    __m512i p_32 = _mm512_set1_epi32(P);
+    __m512i r = _mm512_mullo_epi32(a, b_mul_32);
+            r = _mm512_srli_epi32(r, b_shift);
+            r = _mm512_mullo_epi32(r, p_32);
+            r = _mm512_sub_epi32(a, r);
+    /* r = min(r, r - P) */
+    __m512i rs= _mm512_sub_epi32(r, p_32);
+            r = _mm512_min_epu32(r, rs);
+    return r;
+}
+#endif
+
 /* reduce modulo 509 sixteen 16-bit integers packed into a 256-bit vector
  * each 16-bit integer sould be in the range [0, 508*2] */
 static inline __m256i mm256_mod509_epu16(__m256i a){
@@ -200,6 +244,27 @@ static inline __m256i mm256_exp16mod509_epu16(__m256i a) {
     return r;
 }
 
+#if defined(RSDP)
+/* for each byte x packed into a 256-bit vector, with x in [0, 7], and the
+ * matching byte y in [0, 127], compute FPRED_SINGLE(RESTR_TO_VAL(x) * y):
+ * the powers of the generator are looked up via shuffle, replicated in both
+ * 128b lanes, and multiplied on 16-bit lanes before packing back to bytes */
+static inline __m256i mm256_restr_by_fp_mod127_epu8(__m256i x, __m256i y) {
+    __m256i lut = _mm256_set1_epi64x((int64_t) RESTR_G_TABLE);
+    __m256i mred_mask = _mm256_set1_epi16((uint16_t)0x007f);
+    __m256i zero = _mm256_setzero_si256();
+    x = _mm256_shuffle_epi8(lut, x);
+    __m256i lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(x, zero),
+                                    _mm256_unpacklo_epi8(y, zero));
+    __m256i hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(x, zero),
+                                    _mm256_unpackhi_epi8(y, zero));
+    /* vector Mersenne reduction, both halves fit a byte afterwards */
+    lo = _mm256_add_epi16(_mm256_and_si256(lo, mred_mask), _mm256_srli_epi16(lo, 7));
+    hi = _mm256_add_epi16(_mm256_and_si256(hi, mred_mask), _mm256_srli_epi16(hi, 7));
+    return _mm256_packus_epi16(lo, hi);
+}
+#endif
+
 #endif
 
 
@@ -247,10 +312,76 @@ void restr_vec_by_fp_matrix(FP_ELEM res[N-K],
 
 
 #if defined(RSDP)
-#if defined(HIGH_PERFORMANCE_X86_64)
+#if defined(HIGH_PERFORMANCE_X86_64_AVX512BW)
+/* Computes e * [I_k V]^T as the AVX2 variant below, on 512-bit registers.
+ * The N-K accumulators stay in registers for the whole product, and the last
+ * (N-K) mod 32 columns are loaded and stored through a mask, so that the
+ * padding of the V_tr rows is never read */
+#define V_TR_ZMM_REGS (ROUND_UP(N-K,EPI16_PER_ZMM)/EPI16_PER_ZMM)
+#define V_TR_ZMM_TAIL_MASK ((N-K) % EPI16_PER_ZMM == 0 ? ~(__mmask32)0 : \
+                            ((__mmask32)1 << ((N-K) % EPI16_PER_ZMM)) - 1)
+static inline
+void fp_vec_by_fp_matrix(FP_ELEM res[N-K],
+                         FP_ELEM e[N],
+                         FP_DOUBLEPREC V_tr[K][ROUND_UP(N-K,EPI16_PER_REG)]){
+
+    __m512i mred_mask = _mm512_set1_epi16 (0x007f);
+    __m512i res_w[V_TR_ZMM_REGS];
+    for(int j = 0; j < V_TR_ZMM_REGS; j++){
+        __mmask32 cols = (j == V_TR_ZMM_REGS-1) ? V_TR_ZMM_TAIL_MASK :
+                                                  ~(__mmask32)0;
+        res_w[j] = _mm512_cvtepu8_epi16(_mm256_maskz_loadu_epi8(cols,
+                                               &e[K+j*EPI16_PER_ZMM]));
+    }
+
+    /* 4*(P-1)^2 < 2^16: the products of four rows are summed before being
+     * Mersenne reduced, the accumulators stay below 2^16 as K/4*638 < 2^15 */
+    int i = 0;
+    for(; i+4 <= K; i += 4){
+        __m512i e_coeff[4];
+        for(int r = 0; r < 4; r++){
+            e_coeff[r] = _mm512_set1_epi16(e[i+r]);
+        }
+        for(int j = 0; j < V_TR_ZMM_REGS; j++){
+            __mmask32 cols = (j == V_TR_ZMM_REGS-1) ? V_TR_ZMM_TAIL_MASK :
+                                                      ~(__mmask32)0;
+            __m512i tmp = _mm512_setzero_si512();
+            for(int r = 0; r < 4; r++){
+                __m512i V_tr_slice = _mm512_maskz_loadu_epi16(cols,
+                                             &V_tr[i+r][j*EPI16_PER_ZMM]);
+                tmp = _mm512_add_epi16(tmp,
+                                       _mm512_mullo_epi16(e_coeff[r],V_tr_slice));
+            }
+            res_w[j] = _mm512_add_epi16(res_w[j],
+                                        mm512_mred127_epu16(tmp, mred_mask));
+        }
+    }
+    /* remaining K mod 4 rows */
+    for(; i < K; i++){
+        __m512i e_coeff = _mm512_set1_epi16(e[i]);
+        for(int j = 0; j < V_TR_ZMM_REGS; j++){
+            __mmask32 cols = (j == V_TR_ZMM_REGS-1) ? V_TR_ZMM_TAIL_MASK :
+                                                      ~(__mmask32)0;
+            __m512i V_tr_slice = _mm512_maskz_loadu_epi16(cols,
+                                         &V_tr[i][j*EPI16_PER_ZMM]);
+            __m512i tmp = _mm512_mullo_epi16(e_coeff,V_tr_slice);
+            res_w[j] = _mm512_add_epi16(res_w[j],
+                                        mm512_mred127_epu16(tmp, mred_mask));
+        }
+    }
+    /* Save result trimming to regular precision */
+    for(int j = 0; j < V_TR_ZMM_REGS; j++){
+        __mmask32 cols = (j == V_TR_ZMM_REGS-1) ? V_TR_ZMM_TAIL_MASK :
+                                                  ~(__mmask32)0;
+        __m512i r = mm512_mred127_epu16(res_w[j], mred_mask);
+        r = mm512_mred127_epu16(r, mred_mask);
+        _mm512_mask_cvtepi16_storeu_epi8(&res[j*EPI16_PER_ZMM], cols, r);
+    }
+}
+#elif defined(HIGH_PERFORMANCE_X86_64)
 /* Computes e * [I_k V]^T, V is already in transposed form
  * since  */
-static
+static inline
 void fp_vec_by_fp_matrix(FP_ELEM res[N-K],
                          FP_ELEM e[N],
                          FP_DOUBLEPREC V_tr[K][ROUND_UP(N-K,EPI16_PER_REG)]){
@@ -310,7 +441,54 @@ void fp_vec_by_fp_matrix(FP_ELEM res[N-K],
 #endif /* defined(RSDP) */
 
 #if defined(RSDPG)
-#if defined(HIGH_PERFORMANCE_X86_64)
+#if defined(HIGH_PERFORMANCE_X86_64_AVX512BW)
+/* 512-bit variant of the AVX2 product below: the accumulators stay in
+ * registers and the last (N-K) mod 16 columns are loaded and stored through
+ * a mask */
+#define V_TR_ZMM_REGS (ROUND_UP(N-K,EPI32_PER_ZMM)/EPI32_PER_ZMM)
+#define V_TR_ZMM_TAIL_MASK ((N-K) % EPI32_PER_ZMM == 0 ? (__mmask16)0xFFFF : \
+                            (__mmask16)(((uint32_t)1 << ((N-K) % EPI32_PER_ZMM)) - 1))
+static inline
+void fp_vec_by_fp_matrix(FP_ELEM res[N-K], FP_ELEM e[N], FP_DOUBLEPREC V_tr[K][ROUND_UP(N-K,EPI32_PER_REG)]){
+
+    __m512i res_w[V_TR_ZMM_REGS];
+    for(int j = 0; j < V_TR_ZMM_REGS; j++){
+        __mmask16 cols = (j == V_TR_ZMM_REGS-1) ? V_TR_ZMM_TAIL_MASK :
+                                                  (__mmask16)0xFFFF;
+        res_w[j] = _mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(cols,
+                                                &e[K+j*EPI32_PER_ZMM]));
+    }
+
+    /* same reduction schedule as the AVX2 variant, after rows K/3, 2K/3
+     * and K-1, hoisted out of the row loop */
+    const int reduce_after[3] = {K/3, (K/3)*2, K-1};
+    int i = 0;
+    for(int s = 0; s < 3; s++){
+        for(; i <= reduce_after[s]; i++){
+            __m512i e_coeff = _mm512_set1_epi32(e[i]);
+            for(int j = 0; j < V_TR_ZMM_REGS; j++){
+                __mmask16 cols = (j == V_TR_ZMM_REGS-1) ? V_TR_ZMM_TAIL_MASK :
+                                                          (__mmask16)0xFFFF;
+                __m512i V_tr_slice = _mm512_maskz_loadu_epi32(cols,
+                                             &V_tr[i][j*EPI32_PER_ZMM]);
+                /* the high halves of the lanes are zero, thus the 16-bit
+                 * multiply-add computes the same product as a 32-bit
+                 * mullo, in a single uop */
+                __m512i a = _mm512_madd_epi16(e_coeff, V_tr_slice);
+                res_w[j] = _mm512_add_epi32(res_w[j], a);
+            }
+        }
+        for(int j = 0; j < V_TR_ZMM_REGS; j++){
+            res_w[j] = mm512_mod509_epu32(res_w[j]);
+        }
+    }
+    for(int j = 0; j < V_TR_ZMM_REGS; j++){
+        __mmask16 cols = (j == V_TR_ZMM_REGS-1) ? V_TR_ZMM_TAIL_MASK :
+                                                  (__mmask16)0xFFFF;
+        _mm512_mask_cvtepi32_storeu_epi16(&res[j*EPI32_PER_ZMM], cols, res_w[j]);
+    }
+}
+#elif defined(HIGH_PERFORMANCE_X86_64)
 static inline 
 void fp_vec_by_fp_matrix(FP_ELEM res[N-K], FP_ELEM e[N], FP_DOUBLEPREC V_tr[K][ROUND_UP(N-K,EPI32_PER_REG)]){
 
@@ -367,6 +545,284 @@ void fp_vec_by_fp_matrix(FP_ELEM res[N-K],
 #endif /* defined(HIGH_PERFORMANCE_X86_64) */
 #endif /* defined(RSDPG) */
 
+/* Computes the syndromes res[r] = e[r] * [I_k V]^T of the first batch (at
+ * most PAR_HASH_WAYS) vectors at once: each row of V_tr is loaded once per
+ * batch and reused from registers. Two consecutive rows are interleaved in
+ * each lane, so that a single multiply-add computes two products of every
+ * vector. The results match the fp_vec_by_fp_matrix ones, up to the
+ * redundant representation of zero removed by fp_dz_norm_synd */
+#if defined(RSDP)
+#if defined(HIGH_PERFORMANCE_X86_64_AVX512BW)
+static inline
+void fp_mat_by_fp_matrix_batch(const int batch,
+                               FP_ELEM *res[PAR_HASH_WAYS],
+                               FP_ELEM *e[PAR_HASH_WAYS],
+                               FP_DOUBLEPREC V_tr[K][ROUND_UP(N-K,EPI16_PER_REG)]){
+    /* the coefficient pairs e[r][i] | e[r][i+1] << 8 of each vector, twice
+     * per 32-bit word, so that a broadcast from memory fills the 16-bit
+     * lanes. Coefficients are reduced below 2^7+1, thus the two products
+     * summed by maddubs stay below 2^15. Missing vectors are zero */
+    uint32_t e_pairs[PAR_HASH_WAYS][ROUND_UP(K,4)/2] = {{0}};
+    for(int r = 0; r < batch; r++){
+        for(int i = 0; i < K; i += 2){
+            uint32_t pair = FPRED_SINGLE(e[r][i]);
+            if(i+1 < K){
+                pair |= (uint32_t)FPRED_SINGLE(e[r][i+1]) << 8;
+            }
+            e_pairs[r][i/2] = pair * 0x00010001;
+        }
+    }
+    __m512i mred_mask = _mm512_set1_epi16 (0x007f);
+
+    for(int j = 0; j < V_TR_ZMM_REGS; j++){
+        __mmask32 cols = (j == V_TR_ZMM_REGS-1) ? V_TR_ZMM_TAIL_MASK :
+                                                  ~(__mmask32)0;
+        __m512i res_w[PAR_HASH_WAYS];
+        for(int r = 0; r < PAR_HASH_WAYS; r++){
+            res_w[r] = _mm512_setzero_si512();
+            if(r < batch){
+                res_w[r] = _mm512_cvtepu8_epi16(_mm256_maskz_loadu_epi8(cols,
+                                                  &e[r][K+j*EPI16_PER_ZMM]));
+            }
+        }
+        /* two row pairs per step: the sum of two maddubs is below 2^16, and
+         * the reduced ones add up below 2^15 over the K rows */
+        int i = 0;
+        for(; i+4 <= K; i += 4){
+            __m512i V_tr_pair[2];
+            for(int q = 0; q < 2; q++){
+                __m512i lo = _mm512_maskz_loadu_epi16(cols,
+                                     &V_tr[i+2*q][j*EPI16_PER_ZMM]);
+                __m512i hi = _mm512_maskz_loadu_epi16(cols,
+                                     &V_tr[i+2*q+1][j*EPI16_PER_ZMM]);
+                V_tr_pair[q] = _mm512_or_si512(lo, _mm512_slli_epi16(hi, 8));
+            }
+            for(int r = 0; r < PAR_HASH_WAYS; r++){
+                __m512i tmp = _mm512_add_epi16(
+                    _mm512_maddubs_epi16(_mm512_set1_epi32(e_pairs[r][i/2]),
+                                         V_tr_pair[0]),
+                    _mm512_maddubs_epi16(_mm512_set1_epi32(e_pairs[r][i/2+1]),
+                                         V_tr_pair[1]));
+                res_w[r] = _mm512_add_epi16(res_w[r],
+                                            mm512_mred127_epu16(tmp, mred_mask));
+            }
+        }
+        /* remaining K mod 4 rows, paired with a zero one when odd */
+        for(; i < K; i += 2){
+            __m512i V_tr_pair = _mm512_maskz_loadu_epi16(cols,
+                                        &V_tr[i][j*EPI16_PER_ZMM]);
+            if(i+1 < K){
+                __m512i hi = _mm512_maskz_loadu_epi16(cols,
+                                     &V_tr[i+1][j*EPI16_PER_ZMM]);
+                V_tr_pair = _mm512_or_si512(V_tr_pair, _mm512_slli_epi16(hi, 8));
+            }
+            for(int r = 0; r < PAR_HASH_WAYS; r++){
+                __m512i tmp = _mm512_maddubs_epi16(
+                                  _mm512_set1_epi32(e_pairs[r][i/2]), V_tr_pair);
+                res_w[r] = _mm512_add_epi16(res_w[r],
+                                            mm512_mred127_epu16(tmp, mred_mask));
+            }
+        }
+        /* Save result trimming to regular precision */
+        for(int r = 0; r < batch; r++){
+            __m512i t = mm512_mred127_epu16(res_w[r], mred_mask);
+            t = mm512_mred127_epu16(t, mred_mask);
+            _mm512_mask_cvtepi16_storeu_epi8(&res[r][j*EPI16_PER_ZMM], cols, t);
+        }
+    }
+}
+#elif defined(HIGH_PERFORMANCE_X86_64)
+static inline
+void fp_mat_by_fp_matrix_batch(const int batch,
+                               FP_ELEM *res[PAR_HASH_WAYS],
+                               FP_ELEM *e[PAR_HASH_WAYS],
+                               FP_DOUBLEPREC V_tr[K][ROUND_UP(N-K,EPI16_PER_REG)]){
+    /* coefficient pairs as in the AVX-512 variant */
+    uint32_t e_pairs[PAR_HASH_WAYS][ROUND_UP(K,4)/2] = {{0}};
+    alignas(EPI8_PER_REG) FP_DOUBLEPREC res_dprec[PAR_HASH_WAYS][ROUND_UP(N-K,EPI16_PER_REG)] = {{0}};
+    for(int r = 0; r < batch; r++){
+        for(int i = 0; i < K; i += 2){
+            uint32_t pair = FPRED_SINGLE(e[r][i]);
+            if(i+1 < K){
+                pair |= (uint32_t)FPRED_SINGLE(e[r][i+1]) << 8;
+            }
+            e_pairs[r][i/2] = pair * 0x00010001;
+        }
+        for(int i = 0; i < N-K; i++){
+            res_dprec[r][i] = e[r][K+i];
+        }
+    }
+    __m256i mred_mask = _mm256_set1_epi16 (0x007f);
+
+    for(int j = 0; j < ROUND_UP(N-K,EPI16_PER_REG)/EPI16_PER_REG; j++){
+        __m256i res_w[PAR_HASH_WAYS];
+        for(int r = 0; r < PAR_HASH_WAYS; r++){
+            res_w[r] = _mm256_load_si256((__m256i const *) &res_dprec[r][j*EPI16_PER_REG]);
+        }
+        for(int i = 0; i < K; i += 2){
+            __m256i V_tr_pair = _mm256_lddqu_si256(
+                                    (__m256i const *) &V_tr[i][j*EPI16_PER_REG]);
+            if(i+1 < K){
+                __m256i hi = _mm256_lddqu_si256(
+                                 (__m256i const *) &V_tr[i+1][j*EPI16_PER_REG]);
+                V_tr_pair = _mm256_or_si256(V_tr_pair, _mm256_slli_epi16(hi, 8));
+            }
+            for(int r = 0; r < PAR_HASH_WAYS; r++){
+                __m256i tmp = _mm256_maddubs_epi16(
+                                  _mm256_set1_epi32(e_pairs[r][i/2]), V_tr_pair);
+                /* Vector Mersenne reduction */
+                __m256i tmp2 = _mm256_and_si256 (tmp, mred_mask);
+                tmp = _mm256_srli_epi16(tmp, 7);
+                tmp = _mm256_add_epi16(tmp,tmp2);
+                res_w[r] = _mm256_add_epi16(res_w[r],tmp);
+            }
+        }
+        for(int r = 0; r < PAR_HASH_WAYS; r++){
+            _mm256_store_si256((__m256i *) &res_dprec[r][j*EPI16_PER_REG], res_w[r]);
+        }
+    }
+    /* Save result trimming to regular precision */
+    for(int r = 0; r < batch; r++){
+        for(int i = 0; i < N-K; i++){
+            res[r][i] = FPRED_DOUBLE(res_dprec[r][i]);
+        }
+    }
+}
+#endif /* defined(HIGH_PERFORMANCE_X86_64) */
+#elif defined(RSDPG)
+#if defined(HIGH_PERFORMANCE_X86_64_AVX512BW)
+static inline
+void fp_mat_by_fp_matrix_batch(const int batch,
+                               FP_ELEM *res[PAR_HASH_WAYS],
+                               FP_ELEM *e[PAR_HASH_WAYS],
+                               FP_DOUBLEPREC V_tr[K][ROUND_UP(N-K,EPI32_PER_REG)]){
+    /* the coefficient pairs e[r][i] | e[r][i+1] << 16 of each vector,
+     * missing vectors are zero */
+    uint32_t e_pairs[PAR_HASH_WAYS][ROUND_UP(K,2)/2] = {{0}};
+    for(int r = 0; r < batch; r++){
+        for(int i = 0; i < K; i += 2){
+            uint32_t pair = e[r][i];
+            if(i+1 < K){
+                pair |= (uint32_t)e[r][i+1] << 16;
+            }
+            e_pairs[r][i/2] = pair;
+        }
+    }
+
+    for(int j = 0; j < V_TR_ZMM_REGS; j++){
+        __mmask16 cols = (j == V_TR_ZMM_REGS-1) ? V_TR_ZMM_TAIL_MASK :
+                                                  (__mmask16)0xFFFF;
+        __m512i res_w[PAR_HASH_WAYS];
+        for(int r = 0; r < PAR_HASH_WAYS; r++){
+            res_w[r] = _mm512_setzero_si512();
+            if(r < batch){
+                res_w[r] = _mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(cols,
+                                                   &e[r][K+j*EPI32_PER_ZMM]));
+            }
+        }
+        /* a multiply-add of a row pair is below 2*(P-1)^2, the accumulators
+         * are reduced every 16 rows, staying below the 8339743 bound of
+         * mm512_mod509_epu32 */
+        for(int i_0 = 0; i_0 < K; i_0 += 16){
+            const int i_end = (K-i_0 < 16) ? K : i_0+16;
+            for(int i = i_0; i < i_end; i += 2){
+                __m512i V_tr_pair = _mm512_maskz_loadu_epi32(cols,
+                                            &V_tr[i][j*EPI32_PER_ZMM]);
+                if(i+1 < K){
+                    __m512i hi = _mm512_maskz_loadu_epi32(cols,
+                                         &V_tr[i+1][j*EPI32_PER_ZMM]);
+                    V_tr_pair = _mm512_or_si512(V_tr_pair,
+                                                _mm512_slli_epi32(hi, 16));
+                }
+                for(int r = 0; r < PAR_HASH_WAYS; r++){
+                    res_w[r] = _mm512_add_epi32(res_w[r],
+                                   _mm512_madd_epi16(_mm512_set1_epi32(e_pairs[r][i/2]),
+                                                     V_tr_pair));
+                }
+            }
+            for(int r = 0; r < PAR_HASH_WAYS; r++){
+                res_w[r] = mm512_mod509_epu32(res_w[r]);
+            }
+        }
+        for(int r = 0; r < batch; r++){
+            _mm512_mask_cvtepi32_storeu_epi16(&res[r][j*EPI32_PER_ZMM], cols, res_w[r]);
+        }
+    }
+}
+#elif defined(HIGH_PERFORMANCE_X86_64)
+static inline
+void fp_mat_by_fp_matrix_batch(const int batch,
+                               FP_ELEM *res[PAR_HASH_WAYS],
+                               FP_ELEM *e[PAR_HASH_WAYS],
+                               FP_DOUBLEPREC V_tr[K][ROUND_UP(N-K,EPI32_PER_REG)]){
+    /* coefficient pairs as in the AVX-512 variant */
+    uint32_t e_pairs[PAR_HASH_WAYS][ROUND_UP(K,2)/2] = {{0}};
+    alignas(EPI8_PER_REG) FP_DOUBLEPREC res_dprec[PAR_HASH_WAYS][ROUND_UP(N-K,EPI32_PER_REG)] = {{0}};
+    for(int r = 0; r < batch; r++){
+        for(int i = 0; i < K; i += 2){
+            uint32_t pair = e[r][i];
+            if(i+1 < K){
+                pair |= (uint32_t)e[r][i+1] << 16;
+            }
+            e_pairs[r][i/2] = pair;
+        }
+        for(int i = 0; i < N-K; i++){
+            res_dprec[r][i] = e[r][K+i];
+        }
+    }
+
+    for(int j = 0; j < ROUND_UP(N-K,EPI32_PER_REG)/EPI32_PER_REG; j++){
+        __m256i res_w[PAR_HASH_WAYS];
+        for(int r = 0; r < PAR_HASH_WAYS; r++){
+            res_w[r] = _mm256_load_si256((__m256i const *) &res_dprec[r][j*EPI32_PER_REG]);
+        }
+        /* reduction schedule as in the AVX-512 variant */
+        for(int i_0 = 0; i_0 < K; i_0 += 16){
+            const int i_end = (K-i_0 < 16) ? K : i_0+16;
+            for(int i = i_0; i < i_end; i += 2){
+                __m256i V_tr_pair = _mm256_lddqu_si256(
+                                        (__m256i const *) &V_tr[i][j*EPI32_PER_REG]);
+                if(i+1 < K){
+                    __m256i hi = _mm256_lddqu_si256(
+                                     (__m256i const *) &V_tr[i+1][j*EPI32_PER_REG]);
+                    V_tr_pair = _mm256_or_si256(V_tr_pair,
+                                                _mm256_slli_epi32(hi, 16));
+                }
+                for(int r = 0; r < PAR_HASH_WAYS; r++){
+                    res_w[r] = _mm256_add_epi32(res_w[r],
+                                   _mm256_madd_epi16(_mm256_set1_epi32(e_pairs[r][i/2]),
+                                                     V_tr_pair));
+                }
+            }
+            for(int r = 0; r < PAR_HASH_WAYS; r++){
+                res_w[r] = mm256_mod509_epu32(res_w[r]);
+            }
+        }
+        for(int r = 0; r < PAR_HASH_WAYS; r++){
+            _mm256_store_si256((__m256i *) &res_dprec[r][j*EPI32_PER_REG], res_w[r]);
+        }
+    }
+    for(int r = 0; r < batch; r++){
+        for(int i = 0; i < N-K; i++){
+            res[r][i] = res_dprec[r][i];
+        }
+    }
+}
+#endif /* defined(HIGH_PERFORMANCE_X86_64) */
+#endif /* defined(RSDPG) */
+
+#if !defined(HIGH_PERFORMANCE_X86_64) /* no AVX2, one vector at a time */
+static inline
+void fp_mat_by_fp_matrix_batch(const int batch,
+                               FP_ELEM *res[PAR_HASH_WAYS],
+                               FP_ELEM *e[PAR_HASH_WAYS],
+                               FP_ELEM V_tr[K][N-K]){
+    for(int r = 0; r < batch; r++){
+        fp_vec_by_fp_matrix(res[r], e[r], V_tr);
+    }
+}
+#endif
+
 static inline
 void fp_vec_by_fp_vec_pointwise(FP_ELEM res[N],
                                 const FP_ELEM in1[N],
@@ -377,6 +833,51 @@ void fp_vec_by_fp_vec_pointwise(FP_ELEM res[N],
     }
 }
 
+#if defined(RSDP) && defined(HIGH_PERFORMANCE_X86_64)
+static inline
+void restr_by_fp_vec_pointwise(FP_ELEM res[N],
+                                const FZ_ELEM in1[N],
+                                const FP_ELEM in2[N]){
+    alignas(EPI8_PER_REG) FZ_ELEM in1_align[ROUND_UP(N,EPI8_PER_REG)];
+    alignas(EPI8_PER_REG) FP_ELEM in2_align[ROUND_UP(N,EPI8_PER_REG)];
+    alignas(EPI8_PER_REG) FP_ELEM res_align[ROUND_UP(N,EPI8_PER_REG)];
+    memcpy(in1_align,in1,N);
+    memcpy(in2_align,in2,N);
+
+    for(int i = 0; i < ROUND_UP(N,EPI8_PER_REG)/EPI8_PER_REG; i++ ){
+        __m256i in1_word = _mm256_load_si256( (__m256i const *) &in1_align[i*EPI8_PER_REG]);
+        __m256i in2_word = _mm256_load_si256( (__m256i const *) &in2_align[i*EPI8_PER_REG]);
+        __m256i res_word = mm256_restr_by_fp_mod127_epu8(in1_word, in2_word);
+        _mm256_store_si256 ((__m256i *) &res_align[i*EPI8_PER_REG], res_word);
+    }
+    memcpy(res,res_align,N);
+}
+#elif defined(RSDPG) && defined(HIGH_PERFORMANCE_X86_64)
+static inline
+void restr_by_fp_vec_pointwise(FP_ELEM res[N],
+                                const FZ_ELEM in1[N],
+                                const FP_ELEM in2[N]){
+    /* res: expand, align */
+    alignas(32) FP_ELEM res_x[ROUND_UP(N,EPI16_PER_REG)];
+    /* in1: convert from uint8 to uint16, expand, align */
+    alignas(32) FP_ELEM in1_x[ROUND_UP(N,EPI16_PER_REG)];
+    for (int i = 0; i < N; i++) {
+        in1_x[i] = in1[i];
+    }
+    /* in2: expand, align */
+    alignas(32) FP_ELEM in2_x[ROUND_UP(N,EPI16_PER_REG)];
+    memcpy(in2_x, in2, N*sizeof(FP_ELEM));
+
+    for(int i = 0; i < ROUND_UP(N,EPI16_PER_REG)/EPI16_PER_REG; i++ ){
+        __m256i in1_256 = _mm256_load_si256( (__m256i const *) &in1_x[i*EPI16_PER_REG] );
+        __m256i in2_256 = _mm256_load_si256( (__m256i const *) &in2_x[i*EPI16_PER_REG] );
+        __m256i res_256 = mm256_exp16mod509_epu16(in1_256);
+        res_256 = mm256_mulmod509_epu16(res_256, in2_256);
+        _mm256_store_si256 ((__m256i *) &res_x[i*EPI16_PER_REG], res_256);
+    }
+    memcpy(res, res_x, N*sizeof(FP_ELEM));
+}
+#else /* no AVX2, fallback to plain C */
 static inline
 void restr_by_fp_vec_pointwise(FP_ELEM res[N],
                                 const FZ_ELEM in1[N],
@@ -386,6 +887,100 @@ void restr_by_fp_vec_pointwise(FP_ELEM res[N],
                                (FP_DOUBLEPREC) in2[i]);
     }
 }
+#endif /* defined(HIGH_PERFORMANCE_X86_64) */
+
+/* Fused round kernel: v_bar = e_bar - e_bar_prime, u = RESTR_TO_VAL(v_bar) *
+ * u_prime, in a single pass with v never leaving the registers. The
+ * composition of fz_vec_sub_n, convert_restr_vec_to_fp and
+ * fp_vec_by_fp_vec_pointwise is the reference for it. u may alias u_prime */
+#if defined(RSDP) && defined(HIGH_PERFORMANCE_X86_64)
+static inline
+void restr_diff_by_fp_vec_pointwise(FP_ELEM u[N],
+                                    FZ_ELEM v_bar[N],
+                                    const FZ_ELEM e_bar[N],
+                                    const FZ_ELEM e_bar_prime[N],
+                                    const FP_ELEM u_prime[N]){
+    alignas(EPI8_PER_REG) FZ_ELEM e_bar_align[ROUND_UP(N,EPI8_PER_REG)];
+    alignas(EPI8_PER_REG) FZ_ELEM e_bar_prime_align[ROUND_UP(N,EPI8_PER_REG)];
+    alignas(EPI8_PER_REG) FZ_ELEM v_bar_align[ROUND_UP(N,EPI8_PER_REG)];
+    alignas(EPI8_PER_REG) FP_ELEM u_prime_align[ROUND_UP(N,EPI8_PER_REG)];
+    alignas(EPI8_PER_REG) FP_ELEM u_align[ROUND_UP(N,EPI8_PER_REG)];
+    memcpy(e_bar_align,e_bar,N);
+    memcpy(e_bar_prime_align,e_bar_prime,N);
+    memcpy(u_prime_align,u_prime,N);
+    __m256i fz_mask = _mm256_set1_epi8 ((uint8_t)0x07);
+    __m256i carry_mask = _mm256_set1_epi8 ((uint8_t)0x01);
+
+    for(int i = 0; i < ROUND_UP(N,EPI8_PER_REG)/EPI8_PER_REG; i++ ){
+        __m256i e_word = _mm256_load_si256( (__m256i const *) &e_bar_align[i*EPI8_PER_REG]);
+        __m256i e_prime_word = _mm256_load_si256( (__m256i const *) &e_bar_prime_align[i*EPI8_PER_REG]);
+        /* FZRED_SINGLE(e_bar + FZRED_OPPOSITE(e_bar_prime)): the sum
+         * overflows by a single bit, hand-cleared after the 16-bit shift */
+        __m256i v_word = _mm256_add_epi8(e_word,
+                                         _mm256_xor_si256(e_prime_word, fz_mask));
+        v_word = _mm256_add_epi8(_mm256_and_si256(v_word, fz_mask),
+                                 _mm256_and_si256(_mm256_srli_epi16(v_word, 3),
+                                                  carry_mask));
+        _mm256_store_si256 ((__m256i *) &v_bar_align[i*EPI8_PER_REG], v_word);
+
+        __m256i u_prime_word = _mm256_load_si256( (__m256i const *) &u_prime_align[i*EPI8_PER_REG]);
+        __m256i u_word = mm256_restr_by_fp_mod127_epu8(v_word, u_prime_word);
+        _mm256_store_si256 ((__m256i *) &u_align[i*EPI8_PER_REG], u_word);
+    }
+    memcpy(v_bar,v_bar_align,N);
+    memcpy(u,u_align,N);
+}
+#elif defined(RSDPG) && defined(HIGH_PERFORMANCE_X86_64)
+static inline
+void restr_diff_by_fp_vec_pointwise(FP_ELEM u[N],
+                                    FZ_ELEM v_bar[N],
+                                    const FZ_ELEM e_bar[N],
+                                    const FZ_ELEM e_bar_prime[N],
+                                    const FP_ELEM u_prime[N]){
+    /* the restricted vectors are processed as bytes, EPI16_PER_REG at a
+     * time, and widened to 16-bit only for the exponentiation */
+    alignas(32) FZ_ELEM e_bar_align[ROUND_UP(N,EPI16_PER_REG)];
+    alignas(32) FZ_ELEM e_bar_prime_align[ROUND_UP(N,EPI16_PER_REG)];
+    alignas(32) FZ_ELEM v_bar_align[ROUND_UP(N,EPI16_PER_REG)];
+    memcpy(e_bar_align,e_bar,N);
+    memcpy(e_bar_prime_align,e_bar_prime,N);
+    /* u_prime, u: expand, align */
+    alignas(32) FP_ELEM u_prime_x[ROUND_UP(N,EPI16_PER_REG)];
+    alignas(32) FP_ELEM u_x[ROUND_UP(N,EPI16_PER_REG)];
+    memcpy(u_prime_x, u_prime, N*sizeof(FP_ELEM));
+    __m128i fz_mask = _mm_set1_epi8 ((uint8_t)0x7f);
+    __m128i carry_mask = _mm_set1_epi8 ((uint8_t)0x01);
+
+    for(int i = 0; i < ROUND_UP(N,EPI16_PER_REG)/EPI16_PER_REG; i++ ){
+        __m128i e_word = _mm_load_si128( (__m128i const *) &e_bar_align[i*EPI16_PER_REG]);
+        __m128i e_prime_word = _mm_load_si128( (__m128i const *) &e_bar_prime_align[i*EPI16_PER_REG]);
+        /* FZRED_SINGLE(e_bar + FZRED_OPPOSITE(e_bar_prime)) */
+        __m128i v_word = _mm_add_epi8(e_word,
+                                      _mm_xor_si128(e_prime_word, fz_mask));
+        v_word = _mm_add_epi8(_mm_and_si128(v_word, fz_mask),
+                              _mm_and_si128(_mm_srli_epi16(v_word, 7),
+                                            carry_mask));
+        _mm_store_si128 ((__m128i *) &v_bar_align[i*EPI16_PER_REG], v_word);
+
+        __m256i u_prime_256 = _mm256_load_si256( (__m256i const *) &u_prime_x[i*EPI16_PER_REG] );
+        __m256i u_256 = mm256_exp16mod509_epu16(_mm256_cvtepu8_epi16(v_word));
+        u_256 = mm256_mulmod509_epu16(u_256, u_prime_256);
+        _mm256_store_si256 ((__m256i *) &u_x[i*EPI16_PER_REG], u_256);
+    }
+    memcpy(v_bar,v_bar_align,N);
+    memcpy(u, u_x, N*sizeof(FP_ELEM));
+}
+#else /* no AVX2, fallback to the composable path */
+static inline
+void restr_diff_by_fp_vec_pointwise(FP_ELEM u[N],
+                                    FZ_ELEM v_bar[N],
+                                    const FZ_ELEM e_bar[N],
+                                    const FZ_ELEM e_bar_prime[N],
+                                    const FP_ELEM u_prime[N]){
+    fz_vec_sub_n(v_bar, e_bar, e_bar_prime);
+    restr_by_fp_vec_pointwise(u, v_bar, u_prime);
+}
+#endif /* defined(HIGH_PERFORMANCE_X86_64) */
 
 /* e*chall_1 + u_prime*/
 #if defined(RSDP)
@@ -0,0 +1,67 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.2 (July 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **/
+
+#pragma once
+
+#include "architecture_detect.h"
+#include "parameters.h"
+
+/* In-memory layout of the public matrices, as consumed by the arithmetic
+ * functions. The AVX2 kernels require the rows of V_tr and W_mat to be
+ * zero-padded to a whole number of registers, with elements widened to the
+ * lane size employed in the computation. The AVX-512 kernels read the same
+ * layout, masking out the padding. The plain C fallback employs the
+ * matrices as they are expanded */
+#if (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDP))
+#define V_TR_ELEM FP_DOUBLEPREC
+#define V_TR_COLS ROUND_UP(N-K,EPI16_PER_REG)
+#elif (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDPG))
+#define V_TR_ELEM FP_DOUBLEPREC
+#define V_TR_COLS ROUND_UP(N-K,EPI32_PER_REG)
+#else
+#define V_TR_ELEM FP_ELEM
+#define V_TR_COLS (N-K)
+#endif
+
+/* the AVX2 kernels stream rows with whole register accesses */
+#if defined(HIGH_PERFORMANCE_X86_64)
+#define MATRIX_ALIGNAS alignas(EPI8_PER_REG)
+#else
+#define MATRIX_ALIGNAS
+#endif
+
+#if (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDPG))
+#define W_MAT_ELEM uint16_t
+#define W_MAT_COLS ROUND_UP(N-M,EPI16_PER_REG)
+#elif defined(RSDPG)
+#define W_MAT_ELEM FZ_ELEM
+#define W_MAT_COLS (N-M)
+#endif
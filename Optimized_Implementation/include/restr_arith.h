@@ -46,6 +46,16 @@
 #define FZ_DOUBLE_ZERO_NORM(x) (((x) + (((x) + 1) >> 7)) & 0x7f)
 #endif
 
+#if defined(HIGH_PERFORMANCE_X86_64_AVX512BW)
+/* Mersenne reduction modulo 127 of thirtytwo 16-bit integers packed into a
+ * 512-bit vector, employed for the F_z elements of RSDPG and the F_p ones of
+ * RSDP, as both moduli are 127 */
+static inline __m512i mm512_mred127_epu16(__m512i a, __m512i mred_mask){
+    __m512i r = _mm512_and_si512(a, mred_mask);
+    a = _mm512_srli_epi16(a, 7);
+    return _mm512_add_epi16(a, r);
+}
+#endif
 
 static inline
 void fz_dz_norm_n(FZ_ELEM v[N]){
@@ -78,7 +88,71 @@ int is_fz_vec_in_restr_group_n(const FZ_ELEM in[N]){
 /* computes the information word * M_G product to obtain an element of G
  * only non systematic portion of M_G = [W I] is used, transposed to improve
  * cache friendliness */
-#if defined(HIGH_PERFORMANCE_X86_64)
+#if defined(HIGH_PERFORMANCE_X86_64_AVX512BW)
+/* 512-bit variant of the AVX2 product below: the accumulators stay in
+ * registers and the last (N-M) mod 32 columns are loaded and stored through
+ * a mask */
+#define W_MAT_ZMM_REGS (ROUND_UP(N-M,EPI16_PER_ZMM)/EPI16_PER_ZMM)
+#define W_MAT_ZMM_TAIL_MASK ((N-M) % EPI16_PER_ZMM == 0 ? ~(__mmask32)0 : \
+                             ((__mmask32)1 << ((N-M) % EPI16_PER_ZMM)) - 1)
+static inline
+void fz_inf_w_by_fz_matrix(FZ_ELEM res[N],
+                           const FZ_ELEM e[M],
+                           /* although W_mat is constant, it is dynamically 
+                            * expanded, ISO C11 forbids const here */
+                           uint16_t W_mat[M][ROUND_UP(N-M,EPI16_PER_REG)]){
+    __m512i mred_mask = _mm512_set1_epi16 (0x007f);
+    __m512i res_w[W_MAT_ZMM_REGS];
+    for(int j = 0; j < W_MAT_ZMM_REGS; j++){
+        res_w[j] = _mm512_setzero_si512();
+    }
+    /* 4*(Z-1)^2 < 2^16: the products of four rows are summed before being
+     * Mersenne reduced */
+    int i = 0;
+    for(; i+4 <= M; i += 4){
+        __m512i e_coeff[4];
+        for(int r = 0; r < 4; r++){
+            e_coeff[r] = _mm512_set1_epi16(e[i+r]);
+        }
+        for(int j = 0; j < W_MAT_ZMM_REGS; j++){
+            __mmask32 cols = (j == W_MAT_ZMM_REGS-1) ? W_MAT_ZMM_TAIL_MASK :
+                                                       ~(__mmask32)0;
+            __m512i tmp = _mm512_setzero_si512();
+            for(int r = 0; r < 4; r++){
+                __m512i W_mat_slice = _mm512_maskz_loadu_epi16(cols,
+                                              &W_mat[i+r][j*EPI16_PER_ZMM]);
+                tmp = _mm512_add_epi16(tmp,
+                                       _mm512_mullo_epi16(e_coeff[r],W_mat_slice));
+            }
+            res_w[j] = _mm512_add_epi16(res_w[j],
+                                        mm512_mred127_epu16(tmp, mred_mask));
+        }
+    }
+    /* remaining M mod 4 rows */
+    for(; i < M; i++){
+        __m512i e_coeff = _mm512_set1_epi16(e[i]);
+        for(int j = 0; j < W_MAT_ZMM_REGS; j++){
+            __mmask32 cols = (j == W_MAT_ZMM_REGS-1) ? W_MAT_ZMM_TAIL_MASK :
+                                                       ~(__mmask32)0;
+            __m512i W_mat_slice = _mm512_maskz_loadu_epi16(cols,
+                                          &W_mat[i][j*EPI16_PER_ZMM]);
+            __m512i tmp = _mm512_mullo_epi16(e_coeff,W_mat_slice);
+            res_w[j] = _mm512_add_epi16(res_w[j],
+                                        mm512_mred127_epu16(tmp, mred_mask));
+        }
+    }
+
+    /* Save result trimming to regular precision */
+    for(int j = 0; j < W_MAT_ZMM_REGS; j++){
+        __mmask32 cols = (j == W_MAT_ZMM_REGS-1) ? W_MAT_ZMM_TAIL_MASK :
+                                                   ~(__mmask32)0;
+        __m512i r = mm512_mred127_epu16(res_w[j], mred_mask);
+        r = mm512_mred127_epu16(r, mred_mask);
+        _mm512_mask_cvtepi16_storeu_epi8(&res[j*EPI16_PER_ZMM], cols, r);
+    }
+    memcpy(res+(N-M),e,M*sizeof(FZ_ELEM));
+}
+#elif defined(HIGH_PERFORMANCE_X86_64)
 static inline
 void fz_inf_w_by_fz_matrix(FZ_ELEM res[N],
                            const FZ_ELEM e[M],
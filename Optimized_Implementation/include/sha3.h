@@ -32,6 +32,7 @@
 #pragma once
 
 #include "architecture_detect.h"
+#include "CROSS_stats.h"
 
 #if defined(SHA_3_LIBKECCAK)
 #include <libkeccak.a.headers/KeccakHash.h>
@@ -55,6 +56,7 @@ void xof_shake_update(SHAKE_STATE_STRUCT *state,
                       const unsigned char *input,
                       unsigned int inputByteLen)
 {
+   COUNT_SHAKE_ABSORBED(inputByteLen);
    Keccak_HashUpdate(state,
                      (const BitSequence *) input,
                      (BitLength) inputByteLen*8 );
@@ -71,6 +73,7 @@ void xof_shake_extract(SHAKE_STATE_STRUCT *state,
                        unsigned char *output,
                        unsigned int outputByteLen)
 {
+   COUNT_SHAKE_SQUEEZED(outputByteLen);
    Keccak_HashSqueeze(state,
                       (BitSequence *) output,
                       (BitLength) outputByteLen*8 );
@@ -106,6 +109,7 @@ void xof_shake_update(SHAKE_STATE_STRUCT *state,
                       const unsigned char *input,
                       unsigned int inputByteLen)
 {
+   COUNT_SHAKE_ABSORBED(inputByteLen);
 #if defined(CATEGORY_1)
    shake128_inc_absorb(state,
                        (const uint8_t *)input,
@@ -131,6 +135,7 @@ static inline
 void xof_shake_extract(SHAKE_STATE_STRUCT *state,
                        unsigned char *output,
                        unsigned int outputByteLen){
+   COUNT_SHAKE_SQUEEZED(outputByteLen);
 #if defined(CATEGORY_1)
    shake128_inc_squeeze(output, outputByteLen, state);
 #else
@@ -155,6 +160,7 @@ static inline void xof_shake_x4_update(SHAKE_X4_STATE_STRUCT *states,
                       const unsigned char *in3,
                       const unsigned char *in4,
                       uint32_t singleInputByteLen) {
+   COUNT_SHAKE_ABSORBED(4*(uint64_t)singleInputByteLen);
    keccak_x4_absorb(states, in1, in2, in3, in4, singleInputByteLen);
 }
 static inline void xof_shake_x4_final(SHAKE_X4_STATE_STRUCT *states) {
@@ -166,6 +172,7 @@ static inline void xof_shake_x4_extract(SHAKE_X4_STATE_STRUCT *states,
                        unsigned char *out3,
                        unsigned char *out4,
                        uint32_t singleOutputByteLen){
+   COUNT_SHAKE_SQUEEZED(4*(uint64_t)singleOutputByteLen);
    keccak_x4_squeeze(states, out1, out2, out3, out4, singleOutputByteLen);
 }
 
@@ -226,10 +233,69 @@ static inline void xof_shake_x4_extract(SHAKE_X4_STATE_STRUCT *states,
 
 #endif
 
+#if defined(HIGH_PERFORMANCE_X86_64_AVX512)
+
+// %%%%%%%%%%%%%%%%%% Self-contained SHAKE x8 Wrappers %%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+/* NULL inputs/outputs mark the instances which are not in use */
+#include "fips202x8.h"
+#define SHAKE_X8_STATE_STRUCT par8_keccak_context
+
+static inline void xof_shake_x8_init(SHAKE_X8_STATE_STRUCT *states) {
+   keccak_x8_init(states);
+}
+static inline void xof_shake_x8_update(SHAKE_X8_STATE_STRUCT *states,
+                      const unsigned char *const in[8],
+                      uint32_t singleInputByteLen) {
+   COUNT_SHAKE_ABSORBED(8*(uint64_t)singleInputByteLen);
+   keccak_x8_absorb(states, in, singleInputByteLen);
+}
+static inline void xof_shake_x8_final(SHAKE_X8_STATE_STRUCT *states) {
+   keccak_x8_finalize(states);
+}
+static inline void xof_shake_x8_extract(SHAKE_X8_STATE_STRUCT *states,
+                       unsigned char *const out[8],
+                       uint32_t singleOutputByteLen){
+   COUNT_SHAKE_SQUEEZED(8*(uint64_t)singleOutputByteLen);
+   keccak_x8_squeeze(states, out, singleOutputByteLen);
+}
+
+#endif
+
+#if defined(HIGH_PERFORMANCE_X86_64)
+
 // %%%%%%%%%%%%%%%%%% Self-contained SHAKE x2 Wrappers %%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
-/* SHAKE_x2 just calls SHAKE_x1 twice. If a suitable SHAKE_x2 implementation becomes
- * available, it should be used instead */
+#include "fips202x2.h"
+#define SHAKE_X2_STATE_STRUCT par2_keccak_context
+
+/* the security level is fixed at compile time by the rate in fips202x4.h */
+static inline void xof_shake_x2_init(SHAKE_X2_STATE_STRUCT *states, int val) {
+   keccak_x2_init(states);
+   /* avoid -Werror=unused-parameter */
+   (void)val;
+}
+static inline void xof_shake_x2_update(SHAKE_X2_STATE_STRUCT *states,
+                      const unsigned char *in1,
+                      const unsigned char *in2,
+                      uint32_t singleInputByteLen) {
+   COUNT_SHAKE_ABSORBED(2*(uint64_t)singleInputByteLen);
+   keccak_x2_absorb(states, in1, in2, singleInputByteLen);
+}
+static inline void xof_shake_x2_final(SHAKE_X2_STATE_STRUCT *states) {
+   keccak_x2_finalize(states);
+}
+static inline void xof_shake_x2_extract(SHAKE_X2_STATE_STRUCT *states,
+                       unsigned char *out1,
+                       unsigned char *out2,
+                       uint32_t singleOutputByteLen){
+   COUNT_SHAKE_SQUEEZED(2*(uint64_t)singleOutputByteLen);
+   keccak_x2_squeeze(states, out1, out2, singleOutputByteLen);
+}
+
+#else
+
+// %%%%%%%%% Self-contained SHAKE x2 Wrappers (AVX2 missing: fallback) %%%%%%%%%%%%
 
 typedef struct {
    SHAKE_STATE_STRUCT state1;
@@ -259,6 +325,8 @@ static inline void xof_shake_x2_extract(SHAKE_X2_STATE_STRUCT *states,
    xof_shake_extract(&(states->state2), out2, singleOutputByteLen);
 }
 
+#endif
+
 // %%%%%%%%%%%%%%%%%%%% Parallel SHAKE State Struct %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 typedef struct {
@@ -30,6 +30,9 @@
  **/
 
 #include <assert.h>
+#if defined(POSIX_THREADS)
+#include <pthread.h>
+#endif
 #include <stdalign.h>
 
 #include "architecture_detect.h"
@@ -70,72 +73,101 @@ void expand_pk(FP_ELEM V_tr[K][N-K],
 #endif
 
 
+/* expands the public matrices from seed_pk, storing them in the layout
+ * employed by the arithmetic functions */
 #if defined(RSDP)
 static
-void expand_sk(FZ_ELEM e_bar[N],
-                         FP_ELEM V_tr[K][N-K],
-                         const uint8_t seed_sk[KEYPAIR_SEED_LENGTH_BYTES]){
-  uint8_t seed_e_seed_pk[2][KEYPAIR_SEED_LENGTH_BYTES];
-
-  /* Expansion of sk->seed, explicit domain separation for CSPRNG, as in keygen */
-  const uint16_t dsc_csprng_seed_sk = CSPRNG_DOMAIN_SEP_CONST + (3*T+1);
-
-  CSPRNG_STATE_T csprng_state;
-  csprng_initialize(&csprng_state, seed_sk, KEYPAIR_SEED_LENGTH_BYTES, dsc_csprng_seed_sk);
-  csprng_randombytes((uint8_t *)seed_e_seed_pk,
-                     2*KEYPAIR_SEED_LENGTH_BYTES,
-                     &csprng_state);
-
-  expand_pk(V_tr, seed_e_seed_pk[1]);
-
-  /* Expansion of seede, explicit domain separation for CSPRNG as in keygen */
-  const uint16_t dsc_csprng_seed_e = CSPRNG_DOMAIN_SEP_CONST + (3*T+3);
-
-  CSPRNG_STATE_T csprng_state_e_bar;
-  csprng_initialize(&csprng_state_e_bar, seed_e_seed_pk[0], KEYPAIR_SEED_LENGTH_BYTES, dsc_csprng_seed_e);
-  csprng_fz_vec(e_bar, &csprng_state_e_bar);
+void expand_pk_in_layout(V_TR_ELEM V_tr_layout[K][V_TR_COLS],
+                         const uint8_t seed_pk[KEYPAIR_SEED_LENGTH_BYTES]){
+#if defined(HIGH_PERFORMANCE_X86_64)
+    FP_ELEM V_tr[K][N-K];
+    expand_pk(V_tr,seed_pk);
+    memset(V_tr_layout,0,K*sizeof(V_tr_layout[0]));
+    for(int i = 0; i < K; i++){
+      for (int j = 0; j < N-K; j++){
+         V_tr_layout[i][j] = V_tr[i][j];
+      }
+    }
+#else
+    expand_pk(V_tr_layout,seed_pk);
+#endif
 }
 #elif defined(RSDPG)
 static
-void expand_sk(FZ_ELEM e_bar[N],
-                         FZ_ELEM e_G_bar[M],
-                         FP_ELEM V_tr[K][N-K],
-                         FZ_ELEM W_mat[M][N-M],
-                         const uint8_t seed_sk[KEYPAIR_SEED_LENGTH_BYTES]){
-  uint8_t seed_e_seed_pk[2][KEYPAIR_SEED_LENGTH_BYTES];
-  CSPRNG_STATE_T csprng_state;
-
-  /* Expansion of sk->seed, explicit domain separation for CSPRNG, as in keygen */
-  const uint16_t dsc_csprng_seed_sk = CSPRNG_DOMAIN_SEP_CONST + (3*T+1);
-
-  csprng_initialize(&csprng_state, seed_sk, KEYPAIR_SEED_LENGTH_BYTES, dsc_csprng_seed_sk);
-  csprng_randombytes((uint8_t *)seed_e_seed_pk,
-                     2*KEYPAIR_SEED_LENGTH_BYTES,
-                     &csprng_state);
-
-  expand_pk(V_tr, W_mat, seed_e_seed_pk[1]);
-
-  /* Expansion of seede, explicit domain separation for CSPRNG as in keygen */
-  const uint16_t dsc_csprng_seed_e = CSPRNG_DOMAIN_SEP_CONST + (3*T+3);
-
-  CSPRNG_STATE_T csprng_state_e_bar;
-  csprng_initialize(&csprng_state_e_bar, seed_e_seed_pk[0], KEYPAIR_SEED_LENGTH_BYTES, dsc_csprng_seed_e);
-  csprng_fz_inf_w(e_G_bar,&csprng_state_e_bar);
-#if (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDPG) )
-    alignas(EPI8_PER_REG) uint16_t W_mat_avx[M][ROUND_UP(N-M,EPI16_PER_REG)] = {{0}};
+void expand_pk_in_layout(V_TR_ELEM V_tr_layout[K][V_TR_COLS],
+                         W_MAT_ELEM W_mat_layout[M][W_MAT_COLS],
+                         const uint8_t seed_pk[KEYPAIR_SEED_LENGTH_BYTES]){
+#if defined(HIGH_PERFORMANCE_X86_64)
+    FP_ELEM V_tr[K][N-K];
+    FZ_ELEM W_mat[M][N-M];
+    expand_pk(V_tr,W_mat,seed_pk);
+    memset(V_tr_layout,0,K*sizeof(V_tr_layout[0]));
+    for(int i = 0; i < K; i++){
+      for (int j = 0; j < N-K; j++){
+         V_tr_layout[i][j] = V_tr[i][j];
+      }
+    }
+    memset(W_mat_layout,0,M*sizeof(W_mat_layout[0]));
     for(int i = 0; i < M; i++){
       for (int j = 0; j < N-M; j++){
-         W_mat_avx[i][j] = W_mat[i][j];
+         W_mat_layout[i][j] = W_mat[i][j];
       }
     }
-  fz_inf_w_by_fz_matrix(e_bar,e_G_bar,W_mat_avx);
 #else
-  fz_inf_w_by_fz_matrix(e_bar,e_G_bar,W_mat);
+    expand_pk(V_tr_layout,W_mat_layout,seed_pk);
 #endif
-  fz_dz_norm_n(e_bar);
 }
 #endif
 
+/* clears sensitive buffers, the volatile access prevents the compiler from
+ * eliding the stores as dead */
+static
+void zeroize(void *const buf, const size_t len){
+    volatile uint8_t *p = (volatile uint8_t *) buf;
+    for(size_t i = 0; i < len; i++){
+        p[i] = 0;
+    }
+}
+
+/* expands the seeds of the par_level rounds listed in round_idx into their
+ * e_bar_prime (resp. e_G_bar_prime) and u_prime, running the CSPRNGs of
+ * the rounds side by side on the parallel Keccak */
+static
+void expand_round_seeds_par(int par_level,
+                            const uint16_t round_idx[],
+                            const uint8_t round_seeds[T*SEED_LENGTH_BYTES],
+                            const uint8_t salt[SALT_LENGTH_BYTES],
+#if defined(RSDP)
+                            FZ_ELEM *const e_bar_prime[],
+#elif defined(RSDPG)
+                            FZ_ELEM *const e_G_bar_prime[],
+#endif
+                            FP_ELEM *const u_prime[]){
+    uint8_t csprng_input[PAR_HASH_WAYS][SEED_LENGTH_BYTES+SALT_LENGTH_BYTES];
+    const unsigned char *inputs[PAR_HASH_WAYS] = {0};
+    uint16_t domain_sep_csprng[PAR_HASH_WAYS] = {0};
+    for(int j = 0; j < par_level; j++){
+        /* CSPRNG is fed with concat(seed,salt,round index) represented
+         * as a 2 bytes little endian unsigned integer */
+        memcpy(csprng_input[j], round_seeds+SEED_LENGTH_BYTES*round_idx[j], SEED_LENGTH_BYTES);
+        memcpy(csprng_input[j]+SEED_LENGTH_BYTES, salt, SALT_LENGTH_BYTES);
+        inputs[j] = csprng_input[j];
+        domain_sep_csprng[j] = CSPRNG_DOMAIN_SEP_CONST+round_idx[j]+(2*T-1);
+    }
+
+    PAR8_CSPRNG_STATE_T csprng_states;
+    csprng_initialize_par8(par_level,
+                           &csprng_states,
+                           inputs,
+                           sizeof(csprng_input[0]),
+                           domain_sep_csprng);
+#if defined(RSDP)
+    csprng_fz_vec_par8(par_level, e_bar_prime, &csprng_states);
+#elif defined(RSDPG)
+    csprng_fz_inf_w_par8(par_level, e_G_bar_prime, &csprng_states);
+#endif
+    csprng_fp_vec_par8(par_level, u_prime, &csprng_states);
+}
 
 void CROSS_keygen(sk_t *SK,
                   pk_t *PK){
@@ -196,223 +228,437 @@ void CROSS_keygen(sk_t *SK,
   pack_fp_syn(PK->s, s);
 }
 
+void CROSS_sk_expand(const sk_t *const SK,
+                     CROSS_sk_expanded_t *const ESK){
+  CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_EXPAND_KEY);
+  uint8_t seed_e_seed_pk[2][KEYPAIR_SEED_LENGTH_BYTES];
+  CSPRNG_STATE_T csprng_state;
+
+  /* Expansion of sk->seed, explicit domain separation for CSPRNG, as in keygen */
+  const uint16_t dsc_csprng_seed_sk = CSPRNG_DOMAIN_SEP_CONST + (3*T+1);
+
+  csprng_initialize(&csprng_state, SK->seed_sk, KEYPAIR_SEED_LENGTH_BYTES, dsc_csprng_seed_sk);
+  csprng_randombytes((uint8_t *)seed_e_seed_pk,
+                     2*KEYPAIR_SEED_LENGTH_BYTES,
+                     &csprng_state);
+
+#if defined(RSDP)
+  expand_pk_in_layout(ESK->V_tr, seed_e_seed_pk[1]);
+#elif defined(RSDPG)
+  expand_pk_in_layout(ESK->V_tr, ESK->W_mat, seed_e_seed_pk[1]);
+#endif
+
+  /* Expansion of seede, explicit domain separation for CSPRNG as in keygen */
+  const uint16_t dsc_csprng_seed_e = CSPRNG_DOMAIN_SEP_CONST + (3*T+3);
+
+  CSPRNG_STATE_T csprng_state_e_bar;
+  csprng_initialize(&csprng_state_e_bar, seed_e_seed_pk[0], KEYPAIR_SEED_LENGTH_BYTES, dsc_csprng_seed_e);
+#if defined(RSDP)
+  csprng_fz_vec(ESK->e_bar, &csprng_state_e_bar);
+#elif defined(RSDPG)
+  csprng_fz_inf_w(ESK->e_G_bar, &csprng_state_e_bar);
+  fz_inf_w_by_fz_matrix(ESK->e_bar, ESK->e_G_bar, ESK->W_mat);
+  fz_dz_norm_n(ESK->e_bar);
+#endif
+  zeroize(seed_e_seed_pk,sizeof(seed_e_seed_pk));
+  zeroize(&csprng_state,sizeof(csprng_state));
+  zeroize(&csprng_state_e_bar,sizeof(csprng_state_e_bar));
+  CROSS_STATS_PHASE_END(CROSS_PHASE_EXPAND_KEY);
+}
+
+void CROSS_sk_expanded_zeroize(CROSS_sk_expanded_t *const ESK){
+    zeroize(ESK,sizeof(CROSS_sk_expanded_t));
+}
+
 /* sign cannot fail */
 void CROSS_sign(const sk_t *SK,
                const char *const m,
                const uint64_t mlen,
                CROSS_sig_t *sig){
-    /* Wipe any residual information in the sig structure allocated by the 
-     * caller */
-    memset(sig,0,sizeof(CROSS_sig_t));
-    /* Key material expansion */
-    FP_ELEM V_tr[K][N-K];
-    FZ_ELEM e_bar[N];
-#if defined(RSDP)
-    expand_sk(e_bar, V_tr, SK->seed_sk);
-#elif defined(RSDPG)
-    FZ_ELEM e_G_bar[M];
-    FZ_ELEM W_mat[M][N-M];
-    expand_sk(e_bar, e_G_bar, V_tr, W_mat, SK->seed_sk);
-#endif
+    CROSS_sk_expanded_t ESK;
+    CROSS_sk_expand(SK,&ESK);
+    CROSS_sign_expanded(&ESK,m,mlen,sig);
+    CROSS_sk_expanded_zeroize(&ESK);
+}
 
-#if (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDP) )
-    /* Expanded */
-    alignas(EPI8_PER_REG) uint16_t V_tr_avx[K][ROUND_UP(N-K,EPI16_PER_REG)] = {{0}};
-    for(int i = 0; i < K; i++){
-      for (int j = 0; j < N-K; j++){
-         V_tr_avx[i][j] = V_tr[i][j];
-      }
-    }
-#elif (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDPG) )
-    alignas(EPI8_PER_REG) FP_DOUBLEPREC V_tr_avx[K][ROUND_UP(N-K,EPI32_PER_REG)] = {{0}};
-    for(int i = 0; i < K; i++){
-      for (int j = 0; j < N-K; j++){
-         V_tr_avx[i][j] = V_tr[i][j];
-      }
+/* rounds are split among the workers in whole batches of PAR_HASH_WAYS */
+#define MAX_WORKERS ((T+PAR_HASH_WAYS-1)/PAR_HASH_WAYS)
+
+#if defined(POSIX_THREADS)
+typedef struct {
+    void (*job)(void *arg, int worker);
+    void *arg;
+    int worker;
+} worker_thread_t;
+
+static
+void *worker_thread_main(void *thread_arg){
+    const worker_thread_t *const w = (const worker_thread_t *) thread_arg;
+    w->job(w->arg, w->worker);
+    return NULL;
+}
+
+/* runs job(arg, w) for w in [0, num_workers): worker 0 in the calling
+ * thread, the others on POSIX threads. The job of a thread which cannot be
+ * created is run in the calling thread, so that the call cannot fail */
+static
+void run_workers_pthreads(void (*job)(void *arg, int worker),
+                          void *arg,
+                          const int num_workers){
+    pthread_t threads[MAX_WORKERS];
+    worker_thread_t workers[MAX_WORKERS];
+    int is_started[MAX_WORKERS] = {0};
+    for(int w = 1; w < num_workers; w++){
+        workers[w].job = job;
+        workers[w].arg = arg;
+        workers[w].worker = w;
+        is_started[w] = (pthread_create(&threads[w], NULL,
+                                        worker_thread_main, &workers[w]) == 0);
     }
-#endif
-#if (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDPG) )
-    alignas(EPI8_PER_REG) uint16_t W_mat_avx[M][ROUND_UP(N-M,EPI16_PER_REG)] = {{0}};
-    for(int i = 0; i < M; i++){
-      for (int j = 0; j < N-M; j++){
-         W_mat_avx[i][j] = W_mat[i][j];
-      }
+    job(arg, 0);
+    for(int w = 1; w < num_workers; w++){
+        if(is_started[w]){
+            pthread_join(threads[w], NULL);
+        } else {
+            job(arg, w);
+        }
     }
+}
 #endif
 
-    uint8_t root_seed[SEED_LENGTH_BYTES];
-    randombytes(root_seed,SEED_LENGTH_BYTES);
-    randombytes(sig->salt,SALT_LENGTH_BYTES);
-
-#if defined(NO_TREES)
-    unsigned char round_seeds[T*SEED_LENGTH_BYTES] = {0};
-    seed_leaves(round_seeds,root_seed,sig->salt);
-#else
-    uint8_t seed_tree[SEED_LENGTH_BYTES*NUM_NODES_SEED_TREE] = {0};
-    gen_seed_tree(seed_tree,root_seed,sig->salt);
-    unsigned char round_seeds[T*SEED_LENGTH_BYTES] = {0};
-    seed_leaves(round_seeds, seed_tree);
+#if !defined(LOW_MEMORY_SIGN)
+/* state of a signature shared by the jobs working on its rounds: each job
+ * reads the seeds and writes the outputs of a disjoint range of rounds */
+typedef struct {
+    const CROSS_sk_expanded_t *ESK;
+    const uint8_t *round_seeds;
+    const uint8_t *salt;
+    int num_workers;
+    FZ_ELEM (*e_bar_prime)[N];
+    FZ_ELEM (*v_bar)[N];
+#if defined(RSDPG)
+    FZ_ELEM (*v_G_bar)[M];
+#endif
+    FP_ELEM (*u_prime)[N];
+    uint8_t (*cmt_0)[HASH_DIGEST_LENGTH];
+    uint8_t *cmt_1;
+    const FP_ELEM *chall_1;
+    FP_ELEM (*y)[N];
+    uint8_t *y_digest_chall_1;
+} sign_rounds_t;
+
+/* computes the commitments of the rounds in [begin, end) */
+static
+void sign_commit_rounds(const sign_rounds_t *const ctx,
+                        const int begin,
+                        const int end){
+    /* the expanded key is constant, ISO C11 forbids const in the
+     * arithmetic function prototypes */
+    V_TR_ELEM (*V_tr)[V_TR_COLS] = (V_TR_ELEM (*)[V_TR_COLS]) ctx->ESK->V_tr;
+    FZ_ELEM *e_bar = (FZ_ELEM *) ctx->ESK->e_bar;
+#if defined(RSDPG)
+    W_MAT_ELEM (*W_mat)[W_MAT_COLS] = (W_MAT_ELEM (*)[W_MAT_COLS]) ctx->ESK->W_mat;
+    FZ_ELEM *e_G_bar = (FZ_ELEM *) ctx->ESK->e_G_bar;
+    FZ_ELEM (*v_G_bar)[M] = ctx->v_G_bar;
 #endif
+    FZ_ELEM (*e_bar_prime)[N] = ctx->e_bar_prime;
+    FZ_ELEM (*v_bar)[N] = ctx->v_bar;
+    FP_ELEM (*u_prime)[N] = ctx->u_prime;
+    uint8_t (*cmt_0)[HASH_DIGEST_LENGTH] = ctx->cmt_0;
+    uint8_t *cmt_1 = ctx->cmt_1;
 
-    FZ_ELEM e_bar_prime[T][N];
-    FZ_ELEM v_bar[T][N];
-    FP_ELEM u_prime[T][N];
-    FP_ELEM s_prime[N-K];
+    FP_ELEM u[PAR_HASH_WAYS][N];
+    FP_ELEM s_prime[PAR_HASH_WAYS][N-K];
 
 #if defined(RSDP)
-    uint8_t cmt_0_i_input[4][DENSELY_PACKED_FP_SYN_SIZE+
+    uint8_t cmt_0_i_input[PAR_HASH_WAYS][DENSELY_PACKED_FP_SYN_SIZE+
                              DENSELY_PACKED_FZ_VEC_SIZE+
                              SALT_LENGTH_BYTES];
-    uint16_t cmt_0_i_input_dsc[4];
+    uint16_t cmt_0_i_input_dsc[PAR_HASH_WAYS];
     const int offset_salt = DENSELY_PACKED_FP_SYN_SIZE+DENSELY_PACKED_FZ_VEC_SIZE;
 #elif defined(RSDPG)
-    FZ_ELEM e_G_bar_prime[M];
-    FZ_ELEM v_G_bar[T][M];
-    uint8_t cmt_0_i_input[4][DENSELY_PACKED_FP_SYN_SIZE+
+    FZ_ELEM e_G_bar_prime[PAR_HASH_WAYS][M];
+    uint8_t cmt_0_i_input[PAR_HASH_WAYS][DENSELY_PACKED_FP_SYN_SIZE+
                              DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE+
                              SALT_LENGTH_BYTES];
-    uint16_t cmt_0_i_input_dsc[4];
+    uint16_t cmt_0_i_input_dsc[PAR_HASH_WAYS];
     const int offset_salt = DENSELY_PACKED_FP_SYN_SIZE+DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE;
 #endif
 
-    uint8_t cmt_1_i_input[4][SEED_LENGTH_BYTES+
+    uint8_t cmt_1_i_input[PAR_HASH_WAYS][SEED_LENGTH_BYTES+
                              SALT_LENGTH_BYTES];
-    uint16_t cmt_1_i_input_dsc[4];
+    uint16_t cmt_1_i_input_dsc[PAR_HASH_WAYS];
 
     /* place the salt in the hash input for all parallel instances of keccak */
-    for(int instance=0; instance<4; instance++) {
+    for(int instance=0; instance<PAR_HASH_WAYS; instance++) {
       /* cmt_0_i_input is syndrome|| v_bar resp. v_G_bar ||salt ; place salt at the end */
-      memcpy(cmt_0_i_input[instance]+offset_salt, sig->salt, SALT_LENGTH_BYTES);
+      memcpy(cmt_0_i_input[instance]+offset_salt, ctx->salt, SALT_LENGTH_BYTES);
       /* cmt_1_i_input is concat(seed,salt,round index) */
-      memcpy(cmt_1_i_input[instance]+SEED_LENGTH_BYTES, sig->salt, SALT_LENGTH_BYTES);
+      memcpy(cmt_1_i_input[instance]+SEED_LENGTH_BYTES, ctx->salt, SALT_LENGTH_BYTES);
     }
 
-    uint8_t cmt_0[T][HASH_DIGEST_LENGTH] = {0};
-    uint8_t cmt_1[T*HASH_DIGEST_LENGTH] = {0};
+    /* the rounds are computed in batches of PAR_HASH_WAYS (or less on the
+     * last ones), sharing the seed expansion, the syndrome computation and
+     * the calls to hash */
+    for(int i = begin; i < end; i += PAR_HASH_WAYS){
+        const int par_level = (end-i < PAR_HASH_WAYS) ? end-i : PAR_HASH_WAYS;
 
-    /* enqueue the calls to hash */
-    int to_hash = 0;
-    int round_idx_queue[4] = {0};
-
-    CSPRNG_STATE_T csprng_state;
-    for(uint16_t i = 0; i<T; i++){
-        to_hash++;
-        round_idx_queue[to_hash-1] = i;
-        /* CSPRNG is fed with concat(seed,salt,round index) represented
-         * as a 2 bytes little endian unsigned integer */
-        uint8_t csprng_input[SEED_LENGTH_BYTES+SALT_LENGTH_BYTES];
-        memcpy(csprng_input,round_seeds+SEED_LENGTH_BYTES*i,SEED_LENGTH_BYTES);
-        memcpy(csprng_input+SEED_LENGTH_BYTES,sig->salt,SALT_LENGTH_BYTES);
-
-        uint16_t domain_sep_csprng = CSPRNG_DOMAIN_SEP_CONST+i+(2*T-1);
-
-        /* expand seed[i] into seed_e and seed_u */
-        csprng_initialize(&csprng_state,
-                          csprng_input,
-                          SEED_LENGTH_BYTES+SALT_LENGTH_BYTES,
-                          domain_sep_csprng);
-        /* expand e_bar_prime */
+        /* expand the seeds of the rounds into e_bar_prime resp.
+         * e_G_bar_prime and u_prime */
+        uint16_t round_idx[PAR_HASH_WAYS];
 #if defined(RSDP)
-        csprng_fz_vec(e_bar_prime[i], &csprng_state);
+        FZ_ELEM *e_ptrs[PAR_HASH_WAYS];
 #elif defined(RSDPG)
-        csprng_fz_inf_w(e_G_bar_prime, &csprng_state);
-        fz_vec_sub_m(v_G_bar[i], e_G_bar, e_G_bar_prime);
-        fz_dz_norm_m(v_G_bar[i]);
-#if defined(HIGH_PERFORMANCE_X86_64)
-        fz_inf_w_by_fz_matrix(e_bar_prime[i], e_G_bar_prime,W_mat_avx);
-#else
-        fz_inf_w_by_fz_matrix(e_bar_prime[i], e_G_bar_prime, W_mat);
+        FZ_ELEM *e_G_ptrs[PAR_HASH_WAYS];
 #endif
-        fz_dz_norm_n(e_bar_prime[i]);
+        FP_ELEM *u_prime_ptrs[PAR_HASH_WAYS];
+        for(int j = 0; j < par_level; j++){
+            round_idx[j] = i+j;
+#if defined(RSDP)
+            e_ptrs[j] = e_bar_prime[i+j];
+#elif defined(RSDPG)
+            e_G_ptrs[j] = e_G_bar_prime[j];
+#endif
+            u_prime_ptrs[j] = u_prime[i+j];
+        }
+        expand_round_seeds_par(par_level,
+                               round_idx,
+                               ctx->round_seeds,
+                               ctx->salt,
+#if defined(RSDP)
+                               e_ptrs,
+#elif defined(RSDPG)
+                               e_G_ptrs,
 #endif
-        fz_vec_sub_n(v_bar[i], e_bar, e_bar_prime[i]);
+                               u_prime_ptrs);
+
+        /* the round vectors are left in the redundant representation of
+         * zero yielded by the arithmetic, and normalized as they are packed */
+        FP_ELEM *u_ptrs[PAR_HASH_WAYS];
+        FP_ELEM *s_prime_ptrs[PAR_HASH_WAYS];
+        for(int j = 0; j < par_level; j++){
+            const int round = i+j;
+#if defined(RSDPG)
+            fz_vec_sub_m(v_G_bar[round], e_G_bar, e_G_bar_prime[j]);
+            fz_inf_w_by_fz_matrix(e_bar_prime[round], e_G_bar_prime[j], W_mat);
+#endif
+            restr_diff_by_fp_vec_pointwise(u[j],
+                                           v_bar[round],
+                                           e_bar,
+                                           e_bar_prime[round],
+                                           u_prime[round]);
+            u_ptrs[j] = u[j];
+            s_prime_ptrs[j] = s_prime[j];
+        }
+        fp_mat_by_fp_matrix_batch(par_level, s_prime_ptrs, u_ptrs, V_tr);
 
-        FP_ELEM v[N];
-        convert_restr_vec_to_fp(v, v_bar[i]);
-        fz_dz_norm_n(v_bar[i]);
-        /* expand u_prime */
-        csprng_fp_vec(u_prime[i], &csprng_state);
+        for(int j = 0; j < par_level; j++){
+            const int round = i+j;
+            /* cmt_0_i_input contains s_prime || v_bar resp. v_G_bar || salt */
+            pack_fp_syn(cmt_0_i_input[j],s_prime[j]);
+#if defined(RSDP)
+            pack_fz_vec(cmt_0_i_input[j] + DENSELY_PACKED_FP_SYN_SIZE, v_bar[round]);
+#elif defined(RSDPG)
+            pack_fz_rsdp_g_vec(cmt_0_i_input[j] + DENSELY_PACKED_FP_SYN_SIZE, v_G_bar[round]);
+#endif
+            /* Fixed endianness marshalling of round counter */
+            uint16_t domain_sep_hash = HASH_DOMAIN_SEP_CONST+round+(2*T-1);
+            cmt_0_i_input_dsc[j] = domain_sep_hash;
 
-        FP_ELEM u[N];
-        fp_vec_by_fp_vec_pointwise(u, v, u_prime[i]);
-#if (defined(HIGH_PERFORMANCE_X86_64))
-        fp_vec_by_fp_matrix(s_prime, u, V_tr_avx);
-#else
-        fp_vec_by_fp_matrix(s_prime, u, V_tr);
+            memcpy(cmt_1_i_input[j], ctx->round_seeds+SEED_LENGTH_BYTES*round, SEED_LENGTH_BYTES);
+
+            cmt_1_i_input_dsc[j] = domain_sep_hash;
+        }
+
+        uint8_t *digests[PAR_HASH_WAYS];
+        const unsigned char *inputs[PAR_HASH_WAYS];
+        for(int j = 0; j < PAR_HASH_WAYS; j++){
+            digests[j] = cmt_0[i + (j < par_level ? j : 0)];
+            inputs[j] = cmt_0_i_input[j];
+        }
+        hash_par8(par_level,
+                  digests,
+                  inputs,
+                  sizeof(cmt_0_i_input[0]),
+                  cmt_0_i_input_dsc);
+        for(int j = 0; j < PAR_HASH_WAYS; j++){
+            digests[j] = &cmt_1[(i + (j < par_level ? j : 0))*HASH_DIGEST_LENGTH];
+            inputs[j] = cmt_1_i_input[j];
+        }
+        hash_par8(par_level,
+                  digests,
+                  inputs,
+                  sizeof(cmt_1_i_input[0]),
+                  cmt_1_i_input_dsc);
+    }
+}
+
+/* computes and packs the first round of responses of the rounds in
+ * [begin, end) */
+static
+void sign_respond_rounds(const sign_rounds_t *const ctx,
+                         const int begin,
+                         const int end){
+    for(int i = begin; i < end; i++){
+        fp_vec_by_restr_vec_scaled(ctx->y[i],
+                                   ctx->e_bar_prime[i],
+                                   ctx->chall_1[i],
+                                   ctx->u_prime[i]);
+        /* y vectors are packed before being hashed */
+        pack_fp_vec(ctx->y_digest_chall_1+(i*DENSELY_PACKED_FP_VEC_SIZE),ctx->y[i]);
+    }
+}
 #endif
-        fp_dz_norm_synd(s_prime);
 
-        /* cmt_0_i_input contains s_prime || v_bar resp. v_G_bar || salt */
-        pack_fp_syn(cmt_0_i_input[to_hash-1],s_prime);
+/* splits the T rounds among the workers, in ranges of whole batches of
+ * PAR_HASH_WAYS rounds so that the parallel Keccak lanes are kept full */
+static
+void worker_rounds(const int worker,
+                   const int num_workers,
+                   int *const begin,
+                   int *const end){
+    const int batches = (T+PAR_HASH_WAYS-1)/PAR_HASH_WAYS;
+    const int batches_per_worker = (batches+num_workers-1)/num_workers;
+    *begin = worker*batches_per_worker*PAR_HASH_WAYS;
+    *end = (worker+1)*batches_per_worker*PAR_HASH_WAYS;
+    if(*begin > T) *begin = T;
+    if(*end > T) *end = T;
+}
 
-#if defined(RSDP)
-        pack_fz_vec(cmt_0_i_input[to_hash-1] + DENSELY_PACKED_FP_SYN_SIZE, v_bar[i]);
-#elif defined(RSDPG)
-        pack_fz_rsdp_g_vec(cmt_0_i_input[to_hash-1] + DENSELY_PACKED_FP_SYN_SIZE, v_G_bar[i]);
-#endif
-        /* Fixed endianness marshalling of round counter */
-        uint16_t domain_sep_hash = HASH_DOMAIN_SEP_CONST+i+(2*T-1);
-        cmt_0_i_input_dsc[to_hash-1] = domain_sep_hash;
-
-        memcpy(cmt_1_i_input[to_hash-1], round_seeds+SEED_LENGTH_BYTES*i, SEED_LENGTH_BYTES);
-
-        cmt_1_i_input_dsc[to_hash-1] = domain_sep_hash;
-
-        if(to_hash == 4 || i == T-1){
-            hash_par(
-                to_hash,
-                cmt_0[round_idx_queue[0]],
-                cmt_0[round_idx_queue[1]],
-                cmt_0[round_idx_queue[2]],
-                cmt_0[round_idx_queue[3]],
-                cmt_0_i_input[0],
-                cmt_0_i_input[1],
-                cmt_0_i_input[2],
-                cmt_0_i_input[3],
-                sizeof(cmt_0_i_input)/4,
-                cmt_0_i_input_dsc[0],
-                cmt_0_i_input_dsc[1],
-                cmt_0_i_input_dsc[2],
-                cmt_0_i_input_dsc[3]
-            );
-            hash_par(
-                to_hash,
-                &cmt_1[round_idx_queue[0]*HASH_DIGEST_LENGTH],
-                &cmt_1[round_idx_queue[1]*HASH_DIGEST_LENGTH],
-                &cmt_1[round_idx_queue[2]*HASH_DIGEST_LENGTH],
-                &cmt_1[round_idx_queue[3]*HASH_DIGEST_LENGTH],
-                cmt_1_i_input[0],
-                cmt_1_i_input[1],
-                cmt_1_i_input[2],
-                cmt_1_i_input[3],
-                sizeof(cmt_1_i_input)/4,
-                cmt_1_i_input_dsc[0],
-                cmt_1_i_input_dsc[1],
-                cmt_1_i_input_dsc[2],
-                cmt_1_i_input_dsc[3]
-            );
-            to_hash = 0;
+#if !defined(LOW_MEMORY_SIGN)
+static
+void sign_commit_job(void *arg, int worker){
+    const sign_rounds_t *const ctx = (const sign_rounds_t *) arg;
+    int begin, end;
+    worker_rounds(worker, ctx->num_workers, &begin, &end);
+    sign_commit_rounds(ctx, begin, end);
+}
+
+static
+void sign_respond_job(void *arg, int worker){
+    const sign_rounds_t *const ctx = (const sign_rounds_t *) arg;
+    int begin, end;
+    worker_rounds(worker, ctx->num_workers, &begin, &end);
+    sign_respond_rounds(ctx, begin, end);
+}
+#endif
+
+/* runs job(arg, w) for w in [0, num_workers) through the executor: in the
+ * calling thread when there is a single worker, on POSIX threads when the
+ * executor does not provide its own run function. Without POSIX_THREADS the
+ * jobs of such an executor are run one after the other */
+static
+void run_workers(const CROSS_executor_t *const exec,
+                 const int num_workers,
+                 void (*job)(void *arg, int worker),
+                 void *arg){
+    if(num_workers == 1){
+        job(arg, 0);
+    } else if(exec->run != NULL){
+        exec->run(exec->pool, job, arg, num_workers);
+    } else {
+#if defined(POSIX_THREADS)
+        run_workers_pthreads(job, arg, num_workers);
+#else
+        for(int w = 0; w < num_workers; w++){
+            job(arg, w);
         }
+#endif
     }
+}
 
+#if !defined(LOW_MEMORY_SIGN)
+/* signs the message of digest digest_msg, keeping the per round values in
+ * ws and splitting the rounds among the workers of exec (single threaded if
+ * NULL) */
+static
+void sign_expanded_exec(const CROSS_sk_expanded_t *const ESK,
+                        const uint8_t digest_msg[HASH_DIGEST_LENGTH],
+                        CROSS_sig_t *sig,
+                        const CROSS_executor_t *const exec,
+                        CROSS_sign_scratch_t *const ws){
+    /* Wipe any residual information in the sig structure allocated by the 
+     * caller */
+    memset(sig,0,sizeof(CROSS_sig_t));
+
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_SEED_TREE);
+    uint8_t root_seed[SEED_LENGTH_BYTES];
+    randombytes(root_seed,SEED_LENGTH_BYTES);
+    randombytes(sig->salt,SALT_LENGTH_BYTES);
+
+    uint8_t *round_seeds = ws->round_seeds;
+    memset(round_seeds,0,sizeof(ws->round_seeds));
+#if defined(NO_TREES)
+    seed_leaves(round_seeds,root_seed,sig->salt);
+#else
+    uint8_t *seed_tree = ws->seed_tree;
+    memset(seed_tree,0,sizeof(ws->seed_tree));
+    gen_seed_tree(seed_tree,root_seed,sig->salt);
+    seed_leaves(round_seeds, seed_tree);
+#endif
+    CROSS_STATS_PHASE_END(CROSS_PHASE_SEED_TREE);
+
+    FZ_ELEM (*v_bar)[N] = ws->v_bar;
+#if defined(RSDPG)
+    FZ_ELEM (*v_G_bar)[M] = ws->v_G_bar;
+#endif
+
+    uint8_t (*cmt_0)[HASH_DIGEST_LENGTH] = ws->cmt_0;
+    uint8_t *cmt_1 = ws->cmt_1;
+    memset(cmt_0,0,sizeof(ws->cmt_0));
+    memset(cmt_1,0,sizeof(ws->cmt_1));
+
+    FP_ELEM (*y)[N] = ws->y;
+    uint8_t *y_digest_chall_1 = ws->y_digest_chall_1;
+
+    int num_workers = (exec == NULL || exec->num_workers < 1) ? 1 : exec->num_workers;
+    if(num_workers > MAX_WORKERS){
+        num_workers = MAX_WORKERS;
+    }
+    sign_rounds_t rounds = {
+        .ESK = ESK,
+        .round_seeds = round_seeds,
+        .salt = sig->salt,
+        .num_workers = num_workers,
+        .e_bar_prime = ws->e_bar_prime,
+        .v_bar = v_bar,
+#if defined(RSDPG)
+        .v_G_bar = v_G_bar,
+#endif
+        .u_prime = ws->u_prime,
+        .cmt_0 = cmt_0,
+        .cmt_1 = cmt_1,
+        .chall_1 = ws->chall_1,
+        .y = y,
+        .y_digest_chall_1 = y_digest_chall_1
+    };
+
+    /* the rounds are independent up to the commitment digests */
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_ROUNDS);
+    run_workers(exec, num_workers, sign_commit_job, &rounds);
+    CROSS_STATS_PHASE_END(CROSS_PHASE_ROUNDS);
+
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_MERKLE_ROOT);
     /* vector containing d_0 and d_1 from spec */
     uint8_t digest_cmt0_cmt1[2*HASH_DIGEST_LENGTH];
 
 #if defined(NO_TREES)
     tree_root(digest_cmt0_cmt1, cmt_0);
 #else
-    uint8_t merkle_tree[NUM_NODES_MERKLE_TREE * HASH_DIGEST_LENGTH];
+    uint8_t *merkle_tree = ws->merkle_tree;
     tree_root(digest_cmt0_cmt1, merkle_tree, cmt_0);
 #endif
-    hash(digest_cmt0_cmt1 + HASH_DIGEST_LENGTH, cmt_1, sizeof(cmt_1), HASH_DOMAIN_SEP_CONST);
+    hash(digest_cmt0_cmt1 + HASH_DIGEST_LENGTH, cmt_1, sizeof(ws->cmt_1), HASH_DOMAIN_SEP_CONST);
     hash(sig->digest_cmt, digest_cmt0_cmt1, sizeof(digest_cmt0_cmt1), HASH_DOMAIN_SEP_CONST);
+    CROSS_STATS_PHASE_END(CROSS_PHASE_MERKLE_ROOT);
 
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_CHALL_1);
     /* first challenge extraction */
     /* Domain separation for hashing to digest_chall_1 */
     uint8_t digest_msg_cmt_salt[2*HASH_DIGEST_LENGTH+SALT_LENGTH_BYTES];
 
     /* place d_m at the beginning of the input of the hash generating digest_chall_1 */ 
-    hash(digest_msg_cmt_salt, (uint8_t*) m, mlen, HASH_DOMAIN_SEP_CONST);
+    memcpy(digest_msg_cmt_salt, digest_msg, HASH_DIGEST_LENGTH);
     memcpy(digest_msg_cmt_salt+HASH_DIGEST_LENGTH, sig->digest_cmt, HASH_DIGEST_LENGTH);
     memcpy(digest_msg_cmt_salt+2*HASH_DIGEST_LENGTH, sig->salt, SALT_LENGTH_BYTES);
 
@@ -422,32 +668,27 @@ void CROSS_sign(const sk_t *SK,
     // Domain separation unique for expanding digest_chall_1
     const uint16_t dsc_csprng_chall_1 = CSPRNG_DOMAIN_SEP_CONST + (3*T-1);
 
-    FP_ELEM chall_1[T];
+    CSPRNG_STATE_T csprng_state;
     csprng_initialize(&csprng_state,digest_chall_1,sizeof(digest_chall_1), dsc_csprng_chall_1);
-    csprng_fp_vec_chall_1(chall_1, &csprng_state);
+    csprng_fp_vec_chall_1(ws->chall_1, &csprng_state);
+    CROSS_STATS_PHASE_END(CROSS_PHASE_CHALL_1);
 
     /* Computation of the first round of responses */
-    FP_ELEM y[T][N];
-    for(int i = 0; i < T; i++){
-        fp_vec_by_restr_vec_scaled(y[i],
-                                   e_bar_prime[i],
-                                   chall_1[i],
-                                   u_prime[i]);
-        fp_dz_norm(y[i]);
-    }
-    /* y vectors are packed before being hashed */
-    uint8_t y_digest_chall_1[T*DENSELY_PACKED_FP_VEC_SIZE+HASH_DIGEST_LENGTH];
-    for(int x = 0; x < T; x++){
-        pack_fp_vec(y_digest_chall_1+(x*DENSELY_PACKED_FP_VEC_SIZE),y[x]);
-    }
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_Y_PACKING);
+    run_workers(exec, num_workers, sign_respond_job, &rounds);
+    CROSS_STATS_PHASE_END(CROSS_PHASE_Y_PACKING);
+
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_CHALL_2);
     /* Second challenge extraction */
     memcpy(y_digest_chall_1+T*DENSELY_PACKED_FP_VEC_SIZE,digest_chall_1,HASH_DIGEST_LENGTH);
 
-    hash(sig->digest_chall_2, y_digest_chall_1, sizeof(y_digest_chall_1), HASH_DOMAIN_SEP_CONST);
+    hash(sig->digest_chall_2, y_digest_chall_1, sizeof(ws->y_digest_chall_1), HASH_DOMAIN_SEP_CONST);
 
     uint8_t chall_2[T]={0};
     expand_digest_to_fixed_weight(chall_2,sig->digest_chall_2);
+    CROSS_STATS_PHASE_END(CROSS_PHASE_CHALL_2);
 
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_PROOF_PATH);
     /* Computation of the second round of responses */
 
 #if defined(NO_TREES)
@@ -472,130 +713,549 @@ void CROSS_sign(const sk_t *SK,
             published_rsps++;
         }
     }
+    CROSS_STATS_PHASE_END(CROSS_PHASE_PROOF_PATH);
 }
-
-/* verify returns 1 if signature is ok, 0 otherwise */
-int CROSS_verify(const pk_t *const PK,
-                 const char *const m,
-                 const uint64_t mlen,
-                 const CROSS_sig_t *const sig){
-    CSPRNG_STATE_T csprng_state;
-
-    FP_ELEM V_tr[K][N-K];
+#else
+/* Low memory signature schedule, after the MEM_OPT_SIGN_RECOMP_E_V_U,
+ * MEM_OPT_SIGN_RECOMP_Y and MEM_OPT_SIGN_INC_CMT_1 ones of the Cortex-M4
+ * implementation: the rounds are processed in batches of PAR_HASH_WAYS,
+ * e_bar_prime and u_prime are expanded again from the round seeds whenever
+ * they are needed rather than stored for all the T rounds, and the cmt_1
+ * digests and the packed y are absorbed as soon as they are computed. The
+ * rounds are streamed in order, thus the signature is single threaded; it
+ * is the same as the one of the default schedule */
+
+/* expands the seeds of the par_level rounds listed in round_idx into their
+ * e_bar_prime and u_prime, and v_G_bar for RSDP-G */
+static
+void expand_rounds_low_memory(const CROSS_sk_expanded_t *const ESK,
+                              const int par_level,
+                              const uint16_t round_idx[PAR_HASH_WAYS],
+                              const uint8_t round_seeds[T*SEED_LENGTH_BYTES],
+                              const uint8_t salt[SALT_LENGTH_BYTES],
+#if defined(RSDPG)
+                              FZ_ELEM v_G_bar[PAR_HASH_WAYS][M],
+#endif
+                              FZ_ELEM e_bar_prime[PAR_HASH_WAYS][N],
+                              FP_ELEM u_prime[PAR_HASH_WAYS][N]){
 #if defined(RSDP)
-    expand_pk(V_tr,PK->seed_pk);
+    FZ_ELEM *e_ptrs[PAR_HASH_WAYS] = {0};
 #elif defined(RSDPG)
-    FZ_ELEM W_mat[M][N-M];
-    expand_pk(V_tr,W_mat,PK->seed_pk);
+    W_MAT_ELEM (*W_mat)[W_MAT_COLS] = (W_MAT_ELEM (*)[W_MAT_COLS]) ESK->W_mat;
+    FZ_ELEM *e_G_bar = (FZ_ELEM *) ESK->e_G_bar;
+    FZ_ELEM e_G_bar_prime[PAR_HASH_WAYS][M];
+    FZ_ELEM *e_G_ptrs[PAR_HASH_WAYS] = {0};
 #endif
-#if (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDP) )
-    /* Expanded */
-    alignas(EPI8_PER_REG) uint16_t V_tr_avx[K][ROUND_UP(N-K,EPI16_PER_REG)] = {{0}};
-    for(int i = 0; i < K; i++){
-      for (int j = 0; j < N-K; j++){
-         V_tr_avx[i][j] = V_tr[i][j];
-      }
+    FP_ELEM *u_ptrs[PAR_HASH_WAYS] = {0};
+    for(int j = 0; j < par_level; j++){
+#if defined(RSDP)
+        e_ptrs[j] = e_bar_prime[j];
+#elif defined(RSDPG)
+        e_G_ptrs[j] = e_G_bar_prime[j];
+#endif
+        u_ptrs[j] = u_prime[j];
     }
-#elif (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDPG) )
-    alignas(EPI8_PER_REG) FP_DOUBLEPREC V_tr_avx[K][ROUND_UP(N-K,EPI32_PER_REG)] = {{0}};
-    for(int i = 0; i < K; i++){
-      for (int j = 0; j < N-K; j++){
-         V_tr_avx[i][j] = V_tr[i][j];
-      }
+    expand_round_seeds_par(par_level,
+                           round_idx,
+                           round_seeds,
+                           salt,
+#if defined(RSDP)
+                           e_ptrs,
+#elif defined(RSDPG)
+                           e_G_ptrs,
+#endif
+                           u_ptrs);
+#if defined(RSDPG)
+    for(int j = 0; j < par_level; j++){
+        fz_vec_sub_m(v_G_bar[j], e_G_bar, e_G_bar_prime[j]);
+        fz_inf_w_by_fz_matrix(e_bar_prime[j], e_G_bar_prime[j], W_mat);
     }
+#else
+    (void) ESK;
 #endif
-#if (defined(HIGH_PERFORMANCE_X86_64) && defined(RSDPG) )
-    alignas(EPI8_PER_REG) uint16_t W_mat_avx[M][ROUND_UP(N-M,EPI16_PER_REG)] = {{0}};
-    for(int i = 0; i < M; i++){
-      for (int j = 0; j < N-M; j++){
-         W_mat_avx[i][j] = W_mat[i][j];
-      }
+}
+
+/* signs the message of digest digest_msg with the low memory schedule. The
+ * rounds are not split among workers, exec is always NULL as
+ * CROSS_sign_expanded_threaded is not provided with this schedule */
+static
+void sign_expanded_exec(const CROSS_sk_expanded_t *const ESK,
+                        const uint8_t digest_msg[HASH_DIGEST_LENGTH],
+                        CROSS_sig_t *sig,
+                        const CROSS_executor_t *const exec,
+                        CROSS_sign_scratch_t *const ws){
+    (void) exec;
+    /* Wipe any residual information in the sig structure allocated by the
+     * caller */
+    memset(sig,0,sizeof(CROSS_sig_t));
+
+    /* the expanded key is constant, ISO C11 forbids const in the
+     * arithmetic function prototypes */
+    V_TR_ELEM (*V_tr)[V_TR_COLS] = (V_TR_ELEM (*)[V_TR_COLS]) ESK->V_tr;
+    FZ_ELEM *e_bar = (FZ_ELEM *) ESK->e_bar;
+
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_SEED_TREE);
+    uint8_t root_seed[SEED_LENGTH_BYTES];
+    randombytes(root_seed,SEED_LENGTH_BYTES);
+    randombytes(sig->salt,SALT_LENGTH_BYTES);
+
+    uint8_t *round_seeds = ws->round_seeds;
+    memset(round_seeds,0,sizeof(ws->round_seeds));
+#if defined(NO_TREES)
+    seed_leaves(round_seeds,root_seed,sig->salt);
+#else
+    uint8_t *seed_tree = ws->seed_tree;
+    memset(seed_tree,0,sizeof(ws->seed_tree));
+    gen_seed_tree(seed_tree,root_seed,sig->salt);
+    seed_leaves(round_seeds, seed_tree);
+#endif
+    CROSS_STATS_PHASE_END(CROSS_PHASE_SEED_TREE);
+
+    /* values of the batch of rounds being processed */
+    uint16_t round_idx[PAR_HASH_WAYS];
+    FZ_ELEM e_bar_prime[PAR_HASH_WAYS][N];
+    FP_ELEM u_prime[PAR_HASH_WAYS][N];
+    FZ_ELEM v_bar[PAR_HASH_WAYS][N];
+#if defined(RSDPG)
+    FZ_ELEM v_G_bar[PAR_HASH_WAYS][M];
+#endif
+    FP_ELEM y[N];
+    FP_ELEM s_prime[PAR_HASH_WAYS][N-K];
+
+#if defined(RSDP)
+    uint8_t cmt_0_i_input[PAR_HASH_WAYS][DENSELY_PACKED_FP_SYN_SIZE+
+                             DENSELY_PACKED_FZ_VEC_SIZE+
+                             SALT_LENGTH_BYTES];
+    const int offset_salt = DENSELY_PACKED_FP_SYN_SIZE+DENSELY_PACKED_FZ_VEC_SIZE;
+#elif defined(RSDPG)
+    uint8_t cmt_0_i_input[PAR_HASH_WAYS][DENSELY_PACKED_FP_SYN_SIZE+
+                             DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE+
+                             SALT_LENGTH_BYTES];
+    const int offset_salt = DENSELY_PACKED_FP_SYN_SIZE+DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE;
+#endif
+    uint8_t cmt_1_i_input[PAR_HASH_WAYS][SEED_LENGTH_BYTES+
+                             SALT_LENGTH_BYTES];
+    uint16_t domain_sep_hash[PAR_HASH_WAYS];
+    uint8_t cmt_1[PAR_HASH_WAYS][HASH_DIGEST_LENGTH];
+    uint8_t *digests[PAR_HASH_WAYS] = {0};
+    const unsigned char *inputs[PAR_HASH_WAYS] = {0};
+
+    /* place the salt in the hash input for all parallel instances of keccak */
+    for(int instance=0; instance<PAR_HASH_WAYS; instance++) {
+      /* cmt_0_i_input is syndrome|| v_bar resp. v_G_bar ||salt ; place salt at the end */
+      memcpy(cmt_0_i_input[instance]+offset_salt, sig->salt, SALT_LENGTH_BYTES);
+      /* cmt_1_i_input is concat(seed,salt,round index) */
+      memcpy(cmt_1_i_input[instance]+SEED_LENGTH_BYTES, sig->salt, SALT_LENGTH_BYTES);
     }
+
+    uint8_t (*cmt_0)[HASH_DIGEST_LENGTH] = ws->cmt_0;
+    memset(cmt_0,0,sizeof(ws->cmt_0));
+    /* the cmt_1 digests are absorbed in round order */
+    CSPRNG_STATE_T cmt_1_state;
+    hash_init(&cmt_1_state);
+
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_ROUNDS);
+    for(int i = 0; i < T; i += PAR_HASH_WAYS){
+        const int par_level = (T-i < PAR_HASH_WAYS) ? T-i : PAR_HASH_WAYS;
+        for(int j = 0; j < par_level; j++){
+            round_idx[j] = i+j;
+        }
+        expand_rounds_low_memory(ESK, par_level, round_idx, round_seeds, sig->salt,
+#if defined(RSDPG)
+                                 v_G_bar,
+#endif
+                                 e_bar_prime, u_prime);
+        /* u is computed in place of u_prime, which is expanded again for
+         * the responses */
+        FP_ELEM *u_ptrs[PAR_HASH_WAYS];
+        FP_ELEM *s_prime_ptrs[PAR_HASH_WAYS];
+        for(int j = 0; j < par_level; j++){
+            restr_diff_by_fp_vec_pointwise(u_prime[j],
+                                           v_bar[j],
+                                           e_bar,
+                                           e_bar_prime[j],
+                                           u_prime[j]);
+            u_ptrs[j] = u_prime[j];
+            s_prime_ptrs[j] = s_prime[j];
+        }
+        fp_mat_by_fp_matrix_batch(par_level, s_prime_ptrs, u_ptrs, V_tr);
+
+        for(int j = 0; j < par_level; j++){
+            /* cmt_0_i_input contains s_prime || v_bar resp. v_G_bar || salt */
+            pack_fp_syn(cmt_0_i_input[j],s_prime[j]);
+#if defined(RSDP)
+            pack_fz_vec(cmt_0_i_input[j] + DENSELY_PACKED_FP_SYN_SIZE, v_bar[j]);
+#elif defined(RSDPG)
+            pack_fz_rsdp_g_vec(cmt_0_i_input[j] + DENSELY_PACKED_FP_SYN_SIZE, v_G_bar[j]);
 #endif
+            /* Fixed endianness marshalling of round counter */
+            domain_sep_hash[j] = HASH_DOMAIN_SEP_CONST+(i+j)+(2*T-1);
+            memcpy(cmt_1_i_input[j], round_seeds+SEED_LENGTH_BYTES*(i+j), SEED_LENGTH_BYTES);
+        }
+        for(int j = 0; j < par_level; j++){
+            digests[j] = cmt_0[i+j];
+            inputs[j] = cmt_0_i_input[j];
+        }
+        hash_par8(par_level, digests, inputs, sizeof(cmt_0_i_input[0]), domain_sep_hash);
+        for(int j = 0; j < par_level; j++){
+            digests[j] = cmt_1[j];
+            inputs[j] = cmt_1_i_input[j];
+        }
+        hash_par8(par_level, digests, inputs, sizeof(cmt_1_i_input[0]), domain_sep_hash);
+        hash_update(&cmt_1_state, cmt_1[0], par_level*HASH_DIGEST_LENGTH);
+    }
+    CROSS_STATS_PHASE_END(CROSS_PHASE_ROUNDS);
 
-    FP_ELEM s[N-K];
-    uint8_t is_padd_key_ok;
-    is_padd_key_ok = unpack_fp_syn(s,PK->s);
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_MERKLE_ROOT);
+    /* vector containing d_0 and d_1 from spec */
+    uint8_t digest_cmt0_cmt1[2*HASH_DIGEST_LENGTH];
+
+#if defined(NO_TREES)
+    tree_root(digest_cmt0_cmt1, cmt_0);
+#else
+    uint8_t *merkle_tree = ws->merkle_tree;
+    tree_root(digest_cmt0_cmt1, merkle_tree, cmt_0);
+#endif
+    hash_final(digest_cmt0_cmt1 + HASH_DIGEST_LENGTH, &cmt_1_state, HASH_DOMAIN_SEP_CONST);
+    hash(sig->digest_cmt, digest_cmt0_cmt1, sizeof(digest_cmt0_cmt1), HASH_DOMAIN_SEP_CONST);
+    CROSS_STATS_PHASE_END(CROSS_PHASE_MERKLE_ROOT);
 
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_CHALL_1);
+    /* first challenge extraction */
     uint8_t digest_msg_cmt_salt[2*HASH_DIGEST_LENGTH+SALT_LENGTH_BYTES];
-    hash(digest_msg_cmt_salt, (uint8_t*) m, mlen, HASH_DOMAIN_SEP_CONST);
+
+    /* place d_m at the beginning of the input of the hash generating digest_chall_1 */
+    memcpy(digest_msg_cmt_salt, digest_msg, HASH_DIGEST_LENGTH);
     memcpy(digest_msg_cmt_salt+HASH_DIGEST_LENGTH, sig->digest_cmt, HASH_DIGEST_LENGTH);
     memcpy(digest_msg_cmt_salt+2*HASH_DIGEST_LENGTH, sig->salt, SALT_LENGTH_BYTES);
 
     uint8_t digest_chall_1[HASH_DIGEST_LENGTH];
-    hash(digest_chall_1,digest_msg_cmt_salt,sizeof(digest_msg_cmt_salt), HASH_DOMAIN_SEP_CONST);
+    hash(digest_chall_1,digest_msg_cmt_salt,sizeof(digest_msg_cmt_salt),HASH_DOMAIN_SEP_CONST);
 
     // Domain separation unique for expanding digest_chall_1
     const uint16_t dsc_csprng_chall_1 = CSPRNG_DOMAIN_SEP_CONST + (3*T-1);
-    csprng_initialize(&csprng_state,digest_chall_1,sizeof(digest_chall_1), dsc_csprng_chall_1);
 
-    FP_ELEM chall_1[T];
+    FP_ELEM *chall_1 = ws->chall_1;
+    CSPRNG_STATE_T csprng_state;
+    csprng_initialize(&csprng_state,digest_chall_1,sizeof(digest_chall_1), dsc_csprng_chall_1);
     csprng_fp_vec_chall_1(chall_1, &csprng_state);
+    CROSS_STATS_PHASE_END(CROSS_PHASE_CHALL_1);
+
+    /* Computation of the first round of responses, the packed y are
+     * absorbed in round order */
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_Y_PACKING);
+    CSPRNG_STATE_T y_state;
+    hash_init(&y_state);
+    uint8_t y_packed[DENSELY_PACKED_FP_VEC_SIZE];
+    for(int i = 0; i < T; i += PAR_HASH_WAYS){
+        const int par_level = (T-i < PAR_HASH_WAYS) ? T-i : PAR_HASH_WAYS;
+        for(int j = 0; j < par_level; j++){
+            round_idx[j] = i+j;
+        }
+        expand_rounds_low_memory(ESK, par_level, round_idx, round_seeds, sig->salt,
+#if defined(RSDPG)
+                                 v_G_bar,
+#endif
+                                 e_bar_prime, u_prime);
+        for(int j = 0; j < par_level; j++){
+            fp_vec_by_restr_vec_scaled(y,
+                                       e_bar_prime[j],
+                                       chall_1[i+j],
+                                       u_prime[j]);
+            pack_fp_vec(y_packed, y);
+            hash_update(&y_state, y_packed, sizeof(y_packed));
+        }
+    }
+    CROSS_STATS_PHASE_END(CROSS_PHASE_Y_PACKING);
+
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_CHALL_2);
+    /* Second challenge extraction */
+    hash_update(&y_state, digest_chall_1, HASH_DIGEST_LENGTH);
+    hash_final(sig->digest_chall_2, &y_state, HASH_DOMAIN_SEP_CONST);
 
     uint8_t chall_2[T]={0};
     expand_digest_to_fixed_weight(chall_2,sig->digest_chall_2);
+    CROSS_STATS_PHASE_END(CROSS_PHASE_CHALL_2);
+
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_PROOF_PATH);
+    /* Computation of the second round of responses */
 
-    uint8_t is_stree_padding_ok = 0;
 #if defined(NO_TREES)
-    uint8_t round_seeds[T*SEED_LENGTH_BYTES] = {0};
-    is_stree_padding_ok = rebuild_leaves(round_seeds,chall_2,sig->path);
+    tree_proof(sig->proof,cmt_0,chall_2);
+    seed_path(sig->path,round_seeds,chall_2);
 #else
-    uint8_t seed_tree[SEED_LENGTH_BYTES*NUM_NODES_SEED_TREE] = {0};
-    is_stree_padding_ok = rebuild_tree(seed_tree, chall_2, sig->path, sig->salt);
+    tree_proof(sig->proof,merkle_tree,chall_2);
+    seed_path(sig->path,seed_tree,chall_2);
+#endif
 
-    unsigned char round_seeds[T*SEED_LENGTH_BYTES] = {0};
-    seed_leaves(round_seeds, seed_tree);
+    /* the responses of the published rounds are computed again, in
+     * batches of PAR_HASH_WAYS published rounds */
+    int published_rsps = 0;
+    int i = 0;
+    while(i < T){
+        int par_level = 0;
+        for(; i < T && par_level < PAR_HASH_WAYS; i++){
+            if(chall_2[i] == 0){
+                round_idx[par_level] = i;
+                par_level++;
+            }
+        }
+        if(par_level == 0){
+            break;
+        }
+        assert(published_rsps+par_level <= T-W);
+        expand_rounds_low_memory(ESK, par_level, round_idx, round_seeds, sig->salt,
+#if defined(RSDPG)
+                                 v_G_bar,
+#endif
+                                 e_bar_prime, u_prime);
+        for(int j = 0; j < par_level; j++){
+            fp_vec_by_restr_vec_scaled(y,
+                                       e_bar_prime[j],
+                                       chall_1[round_idx[j]],
+                                       u_prime[j]);
+            pack_fp_vec(sig->resp_0[published_rsps+j].y, y);
+#if defined(RSDP)
+            fz_vec_sub_n(v_bar[j], e_bar, e_bar_prime[j]);
+            pack_fz_vec(sig->resp_0[published_rsps+j].v_bar, v_bar[j]);
+#elif defined(RSDPG)
+            pack_fz_rsdp_g_vec(sig->resp_0[published_rsps+j].v_G_bar, v_G_bar[j]);
+#endif
+            domain_sep_hash[j] = HASH_DOMAIN_SEP_CONST+round_idx[j]+(2*T-1);
+            memcpy(cmt_1_i_input[j], round_seeds+SEED_LENGTH_BYTES*round_idx[j], SEED_LENGTH_BYTES);
+            digests[j] = sig->resp_1[published_rsps+j];
+            inputs[j] = cmt_1_i_input[j];
+        }
+        hash_par8(par_level, digests, inputs, sizeof(cmt_1_i_input[0]), domain_sep_hash);
+        published_rsps += par_level;
+    }
+    CROSS_STATS_PHASE_END(CROSS_PHASE_PROOF_PATH);
+}
+#endif
+
+void CROSS_sign_expanded(const CROSS_sk_expanded_t *const ESK,
+                         const char *const m,
+                         const uint64_t mlen,
+                         CROSS_sig_t *sig){
+    uint8_t digest_msg[HASH_DIGEST_LENGTH];
+    hash(digest_msg, (uint8_t*) m, mlen, HASH_DOMAIN_SEP_CONST);
+    CROSS_sign_scratch_t ws;
+    sign_expanded_exec(ESK, digest_msg, sig, NULL, &ws);
+}
+
+#if !defined(LOW_MEMORY_SIGN)
+void CROSS_sign_expanded_threaded(const CROSS_sk_expanded_t *const ESK,
+                                  const char *const m,
+                                  const uint64_t mlen,
+                                  CROSS_sig_t *sig,
+                                  const CROSS_executor_t *const exec){
+    uint8_t digest_msg[HASH_DIGEST_LENGTH];
+    hash(digest_msg, (uint8_t*) m, mlen, HASH_DOMAIN_SEP_CONST);
+    CROSS_sign_scratch_t ws;
+    sign_expanded_exec(ESK, digest_msg, sig, exec, &ws);
+}
+#endif
+
+int CROSS_sign_ws(const sk_t *const SK,
+                  const char *const m,
+                  const uint64_t mlen,
+                  CROSS_sig_t *const sig,
+                  void *const workspace,
+                  const size_t ws_len){
+    /* align the workspace, the slack is part of CROSS_SIGN_WORKSPACE_BYTES */
+    const uintptr_t align = _Alignof(CROSS_sign_workspace_t);
+    const uintptr_t start = (uintptr_t) workspace;
+    const uintptr_t aligned = (start + align - 1) & ~(align - 1);
+    if(workspace == NULL ||
+       ws_len < aligned - start ||
+       ws_len - (aligned - start) < sizeof(CROSS_sign_workspace_t)){
+        return 0;
+    }
+    CROSS_sign_workspace_t *ws = (CROSS_sign_workspace_t *) aligned;
+
+    CROSS_sk_expand(SK,&ws->ESK);
+    uint8_t digest_msg[HASH_DIGEST_LENGTH];
+    hash(digest_msg, (uint8_t*) m, mlen, HASH_DOMAIN_SEP_CONST);
+    sign_expanded_exec(&ws->ESK, digest_msg, sig, NULL, &ws->scratch);
+    zeroize(ws,sizeof(CROSS_sign_workspace_t));
+    return 1;
+}
+
+/* signs n messages with the same secret key, expanded only once */
+void CROSS_sign_batch(const sk_t *const SK,
+                      const size_t n,
+                      const char *const m[],
+                      const uint64_t mlen[],
+                      CROSS_sig_t *const sig[]){
+    CROSS_sk_expanded_t ESK;
+    CROSS_sk_expand(SK,&ESK);
+    for(size_t i = 0; i < n; i++){
+        CROSS_sign_expanded(&ESK,m[i],mlen[i],sig[i]);
+    }
+    CROSS_sk_expanded_zeroize(&ESK);
+}
+
+void CROSS_pk_expand(const pk_t *const PK,
+                     CROSS_pk_expanded_t *const EPK){
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_EXPAND_KEY);
+#if defined(RSDP)
+    expand_pk_in_layout(EPK->V_tr,PK->seed_pk);
+#elif defined(RSDPG)
+    expand_pk_in_layout(EPK->V_tr,EPK->W_mat,PK->seed_pk);
+#endif
+    EPK->is_padd_key_ok = unpack_fp_syn(EPK->s,PK->s);
+    CROSS_STATS_PHASE_END(CROSS_PHASE_EXPAND_KEY);
+}
+
+/* verify returns 1 if signature is ok, 0 otherwise */
+int CROSS_verify(const pk_t *const PK,
+                 const char *const m,
+                 const uint64_t mlen,
+                 const CROSS_sig_t *const sig){
+    CROSS_pk_expanded_t EPK;
+    CROSS_pk_expand(PK,&EPK);
+    return CROSS_verify_expanded(&EPK,m,mlen,sig);
+}
+
+/* state of a verification shared by the jobs working on its rounds: each
+ * job writes the commitments and the packed y of a disjoint range of
+ * rounds, and the outcome of the checks on its responses */
+typedef struct {
+    const CROSS_pk_expanded_t *EPK;
+    const CROSS_sig_t *sig;
+    const FP_ELEM *chall_1;
+    const uint8_t *chall_2;
+    const uint8_t *round_seeds;
+    int num_workers;
+    uint8_t (*cmt_0)[HASH_DIGEST_LENGTH];
+    uint8_t *cmt_1;
+    uint8_t *y_digest_chall_1;
+    int is_signature_ok[MAX_WORKERS];
+    uint8_t is_packed_padd_ok[MAX_WORKERS];
+} verify_rounds_t;
+
+/* recomputes the commitments and y of the rounds in [begin, end) */
+static
+void verify_rounds(verify_rounds_t *const ctx,
+                   const int worker,
+                   const int begin,
+                   const int end){
+    /* the expanded matrices are constant, ISO C11 forbids const in the
+     * arithmetic function prototypes */
+    V_TR_ELEM (*V_tr)[V_TR_COLS] = (V_TR_ELEM (*)[V_TR_COLS]) ctx->EPK->V_tr;
+#if defined(RSDPG)
+    W_MAT_ELEM (*W_mat)[W_MAT_COLS] = (W_MAT_ELEM (*)[W_MAT_COLS]) ctx->EPK->W_mat;
 #endif
+    const FP_ELEM *s = ctx->EPK->s;
+    const CROSS_sig_t *const sig = ctx->sig;
+    const FP_ELEM *chall_1 = ctx->chall_1;
+    const uint8_t *chall_2 = ctx->chall_2;
+    uint8_t (*cmt_0)[HASH_DIGEST_LENGTH] = ctx->cmt_0;
+    uint8_t *cmt_1 = ctx->cmt_1;
+    uint8_t *y_digest_chall_1 = ctx->y_digest_chall_1;
 
 #if defined(RSDP)
-    uint8_t cmt_0_i_input[4][DENSELY_PACKED_FP_SYN_SIZE+
+    uint8_t cmt_0_i_input[PAR_HASH_WAYS][DENSELY_PACKED_FP_SYN_SIZE+
                              DENSELY_PACKED_FZ_VEC_SIZE+
                              SALT_LENGTH_BYTES];
-    uint16_t cmt_0_i_input_dsc[4];
+    uint16_t cmt_0_i_input_dsc[PAR_HASH_WAYS];
     const int offset_salt = DENSELY_PACKED_FP_SYN_SIZE+DENSELY_PACKED_FZ_VEC_SIZE;
 #elif defined(RSDPG)
-    uint8_t cmt_0_i_input[4][DENSELY_PACKED_FP_SYN_SIZE+
+    uint8_t cmt_0_i_input[PAR_HASH_WAYS][DENSELY_PACKED_FP_SYN_SIZE+
                              DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE+
                              SALT_LENGTH_BYTES];
-    uint16_t cmt_0_i_input_dsc[4];
+    uint16_t cmt_0_i_input_dsc[PAR_HASH_WAYS];
     const int offset_salt = DENSELY_PACKED_FP_SYN_SIZE+DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE;
 #endif
 
-    uint8_t cmt_1_i_input[4][SEED_LENGTH_BYTES+SALT_LENGTH_BYTES];
-    uint16_t cmt_1_i_input_dsc[4];
+    uint8_t cmt_1_i_input[PAR_HASH_WAYS][SEED_LENGTH_BYTES+SALT_LENGTH_BYTES];
+    uint16_t cmt_1_i_input_dsc[PAR_HASH_WAYS];
 
     /* place the salt in the hash input for all parallel instances of keccak */
-    for(int instance=0; instance<4; instance++) {
+    for(int instance=0; instance<PAR_HASH_WAYS; instance++) {
       /* cmt_0_i_input is syndrome|| v_bar resp. v_G_bar ||salt */
       memcpy(cmt_0_i_input[instance]+offset_salt, sig->salt, SALT_LENGTH_BYTES);
       /* cmt_1_i_input is concat(seed,salt,round index) */
       memcpy(cmt_1_i_input[instance]+SEED_LENGTH_BYTES, sig->salt, SALT_LENGTH_BYTES);
     }
 
-    uint8_t cmt_0[T][HASH_DIGEST_LENGTH] = {0};
-    uint8_t cmt_1[T*HASH_DIGEST_LENGTH] = {0};
-
-    FZ_ELEM e_bar_prime[N];
-    FP_ELEM u_prime[N];
-
-    FP_ELEM y_prime[N] = {0};
-    FP_ELEM y_prime_H[N-K] = {0};
+    /* the syndromes of the rounds queued for hashing into cmt_0 are
+     * computed together when the queue is flushed */
+    FP_ELEM y_prime[PAR_HASH_WAYS][N] = {{0}};
+    FP_ELEM y_prime_H[PAR_HASH_WAYS][N-K] = {{0}};
     FP_ELEM s_prime[N-K] = {0};
 
-    FP_ELEM y[T][N];
+    /* recompute y[i] for the rounds where the seed is revealed, expanding
+     * the seeds of PAR_HASH_WAYS such rounds at once */
+    uint16_t round_idx_queue_seed[PAR_HASH_WAYS];
+    FZ_ELEM e_bar_prime[PAR_HASH_WAYS][N];
+#if defined(RSDPG)
+    FZ_ELEM e_G_bar_prime[PAR_HASH_WAYS][M];
+#endif
+    FP_ELEM u_prime[PAR_HASH_WAYS][N];
+    int to_expand = 0;
+    for(uint16_t i = begin; i < end; i++){
+        if(chall_2[i] == 1){
+            round_idx_queue_seed[to_expand] = i;
+            to_expand++;
+        }
+        if(to_expand == PAR_HASH_WAYS || (i == end-1 && to_expand > 0)){
+#if defined(RSDP)
+            FZ_ELEM *e_ptrs[PAR_HASH_WAYS];
+#elif defined(RSDPG)
+            FZ_ELEM *e_G_ptrs[PAR_HASH_WAYS];
+#endif
+            FP_ELEM *u_ptrs[PAR_HASH_WAYS];
+            for(int j = 0; j < to_expand; j++){
+#if defined(RSDP)
+                e_ptrs[j] = e_bar_prime[j];
+#elif defined(RSDPG)
+                e_G_ptrs[j] = e_G_bar_prime[j];
+#endif
+                u_ptrs[j] = u_prime[j];
+            }
+            expand_round_seeds_par(to_expand,
+                                   round_idx_queue_seed,
+                                   ctx->round_seeds,
+                                   sig->salt,
+#if defined(RSDP)
+                                   e_ptrs,
+#elif defined(RSDPG)
+                                   e_G_ptrs,
+#endif
+                                   u_ptrs);
+            for(int j = 0; j < to_expand; j++){
+                uint16_t round = round_idx_queue_seed[j];
+#if defined(RSDPG)
+                fz_inf_w_by_fz_matrix(e_bar_prime[j], e_G_bar_prime[j], W_mat);
+#endif
+                FP_ELEM y[N];
+                fp_vec_by_restr_vec_scaled(y,
+                                           e_bar_prime[j],
+                                           chall_1[round],
+                                           u_prime[j]);
+                /* y vectors are packed before being hashed */
+                pack_fp_vec(y_digest_chall_1+(round*DENSELY_PACKED_FP_VEC_SIZE),y);
+            }
+            to_expand = 0;
+        }
+    }
 
     /* enqueue the calls to hash */
     int to_hash_cmt_1 = 0;
     int to_hash_cmt_0 = 0;
-    int round_idx_queue_cmt_1[4] = {0};
-    int round_idx_queue_cmt_0[4] = {0};
+    int round_idx_queue_cmt_1[PAR_HASH_WAYS] = {0};
+    int round_idx_queue_cmt_0[PAR_HASH_WAYS] = {0};
 
+    /* the responses of the rounds before begin belong to other workers */
     int used_rsps = 0;
+    for(int i = 0; i < begin; i++){
+        used_rsps += (chall_2[i] == 0);
+    }
     int is_signature_ok = 1;
     uint8_t is_packed_padd_ok = 1;
-    for(uint16_t i = 0; i< T; i++){
+    for(uint16_t i = begin; i < end; i++){
 
-        uint16_t domain_sep_csprng = CSPRNG_DOMAIN_SEP_CONST + i + (2*T-1);
         uint16_t domain_sep_hash = HASH_DOMAIN_SEP_CONST + i + (2*T-1);
 
         if(chall_2[i] == 1){
@@ -605,56 +1265,30 @@ int CROSS_verify(const pk_t *const PK,
             round_idx_queue_cmt_1[to_hash_cmt_1-1] = i;
 
             memcpy(cmt_1_i_input[to_hash_cmt_1-1],
-                   round_seeds+SEED_LENGTH_BYTES*i,
+                   ctx->round_seeds+SEED_LENGTH_BYTES*i,
                    SEED_LENGTH_BYTES);
 
             cmt_1_i_input_dsc[to_hash_cmt_1-1] = domain_sep_hash;
-
-            /* CSPRNG is fed with concat(seed,salt,round index) represented
-            * as a 2 bytes little endian unsigned integer */
-            const int csprng_input_length = SALT_LENGTH_BYTES+SEED_LENGTH_BYTES;
-            uint8_t csprng_input[csprng_input_length];
-            memcpy(csprng_input+SEED_LENGTH_BYTES,sig->salt,SALT_LENGTH_BYTES);
-            memcpy(csprng_input,round_seeds+SEED_LENGTH_BYTES*i,SEED_LENGTH_BYTES);
-
-            /* expand seed[i] into seed_e and seed_u */
-            csprng_initialize(&csprng_state, csprng_input,csprng_input_length, domain_sep_csprng);
-#if defined(RSDP)
-            /* expand e_bar_prime */
-            csprng_fz_vec(e_bar_prime, &csprng_state);
-#elif defined(RSDPG)
-            FZ_ELEM e_G_bar_prime[M];
-            csprng_fz_inf_w(e_G_bar_prime, &csprng_state);
-#if defined(HIGH_PERFORMANCE_X86_64)
-            fz_inf_w_by_fz_matrix(e_bar_prime, e_G_bar_prime, W_mat_avx);
-#else
-            fz_inf_w_by_fz_matrix(e_bar_prime, e_G_bar_prime, W_mat);
-#endif
-            fz_dz_norm_n(e_bar_prime);
-#endif
-            /* expand u_prime */
-            csprng_fp_vec(u_prime, &csprng_state);
-            fp_vec_by_restr_vec_scaled(y[i],
-                                       e_bar_prime,
-                                       chall_1[i],
-                                       u_prime);
-            fp_dz_norm(y[i]);
         } else {
 
             /* save the index for the hash output */
             to_hash_cmt_0++;
             round_idx_queue_cmt_0[to_hash_cmt_0-1] = i;
 
+            /* y and v_bar (v_G_bar) are always unpacked, as they are hashed even
+             * when invalid */
+            FP_ELEM y[N];
+            is_packed_padd_ok = unpack_fp_vec(y, sig->resp_0[used_rsps].y) &&
+                                is_packed_padd_ok;
             /* place y[i] in the buffer for later on hashing */
-            is_packed_padd_ok = is_packed_padd_ok &&
-                                unpack_fp_vec(y[i], sig->resp_0[used_rsps].y);
+            pack_fp_vec(y_digest_chall_1+(i*DENSELY_PACKED_FP_VEC_SIZE),y);
 
             FZ_ELEM v_bar[N];
 #if defined(RSDP)
             /*v_bar is memcpy'ed directly into cmt_0 input buffer */
             FZ_ELEM* v_bar_ptr = cmt_0_i_input[to_hash_cmt_0-1]+DENSELY_PACKED_FP_SYN_SIZE;
-            is_packed_padd_ok = is_packed_padd_ok &&
-                                unpack_fz_vec(v_bar, sig->resp_0[used_rsps].v_bar);
+            is_packed_padd_ok = unpack_fz_vec(v_bar, sig->resp_0[used_rsps].v_bar) &&
+                                is_packed_padd_ok;
             memcpy(v_bar_ptr,
                    &sig->resp_0[used_rsps].v_bar,
                    DENSELY_PACKED_FZ_VEC_SIZE);
@@ -667,87 +1301,148 @@ int CROSS_verify(const pk_t *const PK,
                    &sig->resp_0[used_rsps].v_G_bar,
                    DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE);
             FZ_ELEM v_G_bar[M];
-            is_packed_padd_ok = is_packed_padd_ok &&
-                                unpack_fz_rsdp_g_vec(v_G_bar, sig->resp_0[used_rsps].v_G_bar);
+            is_packed_padd_ok = unpack_fz_rsdp_g_vec(v_G_bar, sig->resp_0[used_rsps].v_G_bar) &&
+                                is_packed_padd_ok;
             is_signature_ok = is_signature_ok &&
                               is_fz_vec_in_restr_group_m(v_G_bar);
-#if defined(HIGH_PERFORMANCE_X86_64)
-            fz_inf_w_by_fz_matrix(v_bar, v_G_bar, W_mat_avx);
-#else
             fz_inf_w_by_fz_matrix(v_bar, v_G_bar, W_mat);
-#endif
 
 #endif
             memcpy(&cmt_1[i*HASH_DIGEST_LENGTH], sig->resp_1[used_rsps], HASH_DIGEST_LENGTH);
             used_rsps++;
 
-            FP_ELEM v[N];
-            convert_restr_vec_to_fp(v, v_bar);
-            fp_vec_by_fp_vec_pointwise(y_prime, v, y[i]);
-#if (defined(HIGH_PERFORMANCE_X86_64))
-            fp_vec_by_fp_matrix(y_prime_H, y_prime, V_tr_avx);
-            #else
-            fp_vec_by_fp_matrix(y_prime_H, y_prime ,V_tr);
-#endif
-            fp_dz_norm_synd(y_prime_H);
-            fp_synd_minus_fp_vec_scaled(s_prime,
-                                        y_prime_H,
-                                        chall_1[i],
-                                        s);
-            fp_dz_norm_synd(s_prime);
-            pack_fp_syn(cmt_0_i_input[to_hash_cmt_0-1],s_prime);
+            restr_by_fp_vec_pointwise(y_prime[to_hash_cmt_0-1], v_bar, y);
             cmt_0_i_input_dsc[to_hash_cmt_0-1] = domain_sep_hash;
 
         }
 
-        /* hash commitment 1 in batches of 4 (or less on the last round) */
-        if(to_hash_cmt_1 == 4 || i == T-1){
-            hash_par(
-                to_hash_cmt_1,
-                &cmt_1[round_idx_queue_cmt_1[0]*HASH_DIGEST_LENGTH],
-                &cmt_1[round_idx_queue_cmt_1[1]*HASH_DIGEST_LENGTH],
-                &cmt_1[round_idx_queue_cmt_1[2]*HASH_DIGEST_LENGTH],
-                &cmt_1[round_idx_queue_cmt_1[3]*HASH_DIGEST_LENGTH],
-                cmt_1_i_input[0],
-                cmt_1_i_input[1],
-                cmt_1_i_input[2],
-                cmt_1_i_input[3],
-                sizeof(cmt_1_i_input)/4,
-                cmt_1_i_input_dsc[0],
-                cmt_1_i_input_dsc[1],
-                cmt_1_i_input_dsc[2],
-                cmt_1_i_input_dsc[3]
-            );
+        /* hash commitment 1 in batches of PAR_HASH_WAYS (or less on the last round) */
+        if(to_hash_cmt_1 == PAR_HASH_WAYS || (i == end-1 && to_hash_cmt_1 > 0)){
+            uint8_t *digests[PAR_HASH_WAYS];
+            const unsigned char *inputs[PAR_HASH_WAYS];
+            for(int j = 0; j < PAR_HASH_WAYS; j++){
+                digests[j] = &cmt_1[round_idx_queue_cmt_1[j]*HASH_DIGEST_LENGTH];
+                inputs[j] = cmt_1_i_input[j];
+            }
+            hash_par8(to_hash_cmt_1,
+                      digests,
+                      inputs,
+                      sizeof(cmt_1_i_input[0]),
+                      cmt_1_i_input_dsc);
             to_hash_cmt_1 = 0;
         }
-        /* hash commitment 0 in batches of 4 (or less on the last round) */
-        if(to_hash_cmt_0 == 4 || i == T-1){
-            hash_par(
-                to_hash_cmt_0,
-                cmt_0[round_idx_queue_cmt_0[0]],
-                cmt_0[round_idx_queue_cmt_0[1]],
-                cmt_0[round_idx_queue_cmt_0[2]],
-                cmt_0[round_idx_queue_cmt_0[3]],
-                cmt_0_i_input[0],
-                cmt_0_i_input[1],
-                cmt_0_i_input[2],
-                cmt_0_i_input[3],
-                sizeof(cmt_0_i_input)/4,
-                cmt_0_i_input_dsc[0],
-                cmt_0_i_input_dsc[1],
-                cmt_0_i_input_dsc[2],
-                cmt_0_i_input_dsc[3]
-            );
+        /* hash commitment 0 in batches of PAR_HASH_WAYS (or less on the last round) */
+        if(to_hash_cmt_0 == PAR_HASH_WAYS || (i == end-1 && to_hash_cmt_0 > 0)){
+            FP_ELEM *y_prime_ptrs[PAR_HASH_WAYS];
+            FP_ELEM *y_prime_H_ptrs[PAR_HASH_WAYS];
+            for(int j = 0; j < to_hash_cmt_0; j++){
+                y_prime_ptrs[j] = y_prime[j];
+                y_prime_H_ptrs[j] = y_prime_H[j];
+            }
+            fp_mat_by_fp_matrix_batch(to_hash_cmt_0, y_prime_H_ptrs, y_prime_ptrs, V_tr);
+            for(int j = 0; j < to_hash_cmt_0; j++){
+                fp_synd_minus_fp_vec_scaled(s_prime,
+                                            y_prime_H[j],
+                                            chall_1[round_idx_queue_cmt_0[j]],
+                                            s);
+                pack_fp_syn(cmt_0_i_input[j],s_prime);
+            }
+            uint8_t *digests[PAR_HASH_WAYS];
+            const unsigned char *inputs[PAR_HASH_WAYS];
+            for(int j = 0; j < PAR_HASH_WAYS; j++){
+                digests[j] = cmt_0[round_idx_queue_cmt_0[j]];
+                inputs[j] = cmt_0_i_input[j];
+            }
+            hash_par8(to_hash_cmt_0,
+                      digests,
+                      inputs,
+                      sizeof(cmt_0_i_input[0]),
+                      cmt_0_i_input_dsc);
             to_hash_cmt_0 = 0;
-
         }
 
     } /* end for iterating on ZKID iterations */
 
+    ctx->is_signature_ok[worker] = is_signature_ok;
+    ctx->is_packed_padd_ok[worker] = is_packed_padd_ok;
+}
+
+static
+void verify_rounds_job(void *arg, int worker){
+    verify_rounds_t *const ctx = (verify_rounds_t *) arg;
+    int begin, end;
+    worker_rounds(worker, ctx->num_workers, &begin, &end);
+    verify_rounds(ctx, worker, begin, end);
+}
+
+/* verification against an expanded public key, given the first challenge
+ * digest_chall_1 and its expansion chall_1, as derived from the message and
+ * the signature, with the rounds split among the workers of exec (single
+ * threaded if NULL). Returns 1 if signature is ok, 0 otherwise */
+static
+int verify_expanded_chall_1(const CROSS_pk_expanded_t *const EPK,
+                            const uint8_t digest_chall_1[HASH_DIGEST_LENGTH],
+                            const FP_ELEM chall_1[T],
+                            const CROSS_sig_t *const sig,
+                            const CROSS_executor_t *const exec){
+    uint8_t is_padd_key_ok = EPK->is_padd_key_ok;
+
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_CHALL_2);
+    uint8_t chall_2[T]={0};
+    expand_digest_to_fixed_weight(chall_2,sig->digest_chall_2);
+    CROSS_STATS_PHASE_END(CROSS_PHASE_CHALL_2);
+
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_SEED_TREE);
+    uint8_t is_stree_padding_ok = 0;
+#if defined(NO_TREES)
+    uint8_t round_seeds[T*SEED_LENGTH_BYTES] = {0};
+    is_stree_padding_ok = rebuild_leaves(round_seeds,chall_2,sig->path);
+#else
+    uint8_t seed_tree[SEED_LENGTH_BYTES*NUM_NODES_SEED_TREE] = {0};
+    is_stree_padding_ok = rebuild_tree(seed_tree, chall_2, sig->path, sig->salt);
+
+    unsigned char round_seeds[T*SEED_LENGTH_BYTES] = {0};
+    seed_leaves(round_seeds, seed_tree);
+#endif
+    CROSS_STATS_PHASE_END(CROSS_PHASE_SEED_TREE);
+
+    uint8_t cmt_0[T][HASH_DIGEST_LENGTH] = {0};
+    uint8_t cmt_1[T*HASH_DIGEST_LENGTH] = {0};
+    uint8_t y_digest_chall_1[T*DENSELY_PACKED_FP_VEC_SIZE+HASH_DIGEST_LENGTH];
+
+    int num_workers = (exec == NULL || exec->num_workers < 1) ? 1 : exec->num_workers;
+    if(num_workers > MAX_WORKERS){
+        num_workers = MAX_WORKERS;
+    }
+    verify_rounds_t rounds = {
+        .EPK = EPK,
+        .sig = sig,
+        .chall_1 = chall_1,
+        .chall_2 = chall_2,
+        .round_seeds = round_seeds,
+        .num_workers = num_workers,
+        .cmt_0 = cmt_0,
+        .cmt_1 = cmt_1,
+        .y_digest_chall_1 = y_digest_chall_1
+    };
+
+    /* the rounds are independent up to the commitment digests */
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_ROUNDS);
+    run_workers(exec, num_workers, verify_rounds_job, &rounds);
+    CROSS_STATS_PHASE_END(CROSS_PHASE_ROUNDS);
+
+    int is_signature_ok = 1;
+    uint8_t is_packed_padd_ok = 1;
+    for(int w = 0; w < num_workers; w++){
+        is_signature_ok = is_signature_ok && rounds.is_signature_ok[w];
+        is_packed_padd_ok = is_packed_padd_ok && rounds.is_packed_padd_ok[w];
+    }
+
     #ifndef SKIP_ASSERT
     assert(is_signature_ok);
     #endif
 
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_MERKLE_ROOT);
     uint8_t digest_cmt0_cmt1[2*HASH_DIGEST_LENGTH];
 
     uint8_t is_mtree_padding_ok = recompute_root(digest_cmt0_cmt1,
@@ -758,17 +1453,14 @@ int CROSS_verify(const pk_t *const PK,
 
     uint8_t digest_cmt_prime[HASH_DIGEST_LENGTH];
     hash(digest_cmt_prime,digest_cmt0_cmt1,sizeof(digest_cmt0_cmt1), HASH_DOMAIN_SEP_CONST);
+    CROSS_STATS_PHASE_END(CROSS_PHASE_MERKLE_ROOT);
 
-
-    uint8_t y_digest_chall_1[T*DENSELY_PACKED_FP_VEC_SIZE+HASH_DIGEST_LENGTH];
-
-    for(int x = 0; x < T; x++){
-        pack_fp_vec(y_digest_chall_1+(x*DENSELY_PACKED_FP_VEC_SIZE),y[x]);
-    }
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_CHALL_2);
     memcpy(y_digest_chall_1+T*DENSELY_PACKED_FP_VEC_SIZE,digest_chall_1,HASH_DIGEST_LENGTH);
 
     uint8_t digest_chall_2_prime[HASH_DIGEST_LENGTH];
     hash(digest_chall_2_prime, y_digest_chall_1, sizeof(y_digest_chall_1), HASH_DOMAIN_SEP_CONST);
+    CROSS_STATS_PHASE_END(CROSS_PHASE_CHALL_2);
 
 
     int does_digest_cmt_match = ( memcmp(digest_cmt_prime,
@@ -794,3 +1486,173 @@ int CROSS_verify(const pk_t *const PK,
                       is_packed_padd_ok;
     return is_signature_ok;
 }
+
+/* verifies the signature of the message of digest digest_msg, splitting
+ * the rounds among the workers of exec (single threaded if NULL). Returns
+ * 1 if signature is ok, 0 otherwise */
+static
+int verify_expanded_exec(const CROSS_pk_expanded_t *const EPK,
+                         const uint8_t digest_msg[HASH_DIGEST_LENGTH],
+                         const CROSS_sig_t *const sig,
+                         const CROSS_executor_t *const exec){
+    CSPRNG_STATE_T csprng_state;
+
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_CHALL_1);
+    uint8_t digest_msg_cmt_salt[2*HASH_DIGEST_LENGTH+SALT_LENGTH_BYTES];
+    memcpy(digest_msg_cmt_salt, digest_msg, HASH_DIGEST_LENGTH);
+    memcpy(digest_msg_cmt_salt+HASH_DIGEST_LENGTH, sig->digest_cmt, HASH_DIGEST_LENGTH);
+    memcpy(digest_msg_cmt_salt+2*HASH_DIGEST_LENGTH, sig->salt, SALT_LENGTH_BYTES);
+
+    uint8_t digest_chall_1[HASH_DIGEST_LENGTH];
+    hash(digest_chall_1,digest_msg_cmt_salt,sizeof(digest_msg_cmt_salt), HASH_DOMAIN_SEP_CONST);
+
+    // Domain separation unique for expanding digest_chall_1
+    const uint16_t dsc_csprng_chall_1 = CSPRNG_DOMAIN_SEP_CONST + (3*T-1);
+    csprng_initialize(&csprng_state,digest_chall_1,sizeof(digest_chall_1), dsc_csprng_chall_1);
+
+    FP_ELEM chall_1[T];
+    csprng_fp_vec_chall_1(chall_1, &csprng_state);
+    CROSS_STATS_PHASE_END(CROSS_PHASE_CHALL_1);
+
+    return verify_expanded_chall_1(EPK, digest_chall_1, chall_1, sig, exec);
+}
+
+/* verify returns 1 if signature is ok, 0 otherwise */
+int CROSS_verify_expanded(const CROSS_pk_expanded_t *const EPK,
+                          const char *const m,
+                          const uint64_t mlen,
+                          const CROSS_sig_t *const sig){
+    uint8_t digest_msg[HASH_DIGEST_LENGTH];
+    hash(digest_msg, (uint8_t*) m, mlen, HASH_DOMAIN_SEP_CONST);
+    return verify_expanded_exec(EPK, digest_msg, sig, NULL);
+}
+
+/* verify returns 1 if signature is ok, 0 otherwise */
+int CROSS_verify_expanded_threaded(const CROSS_pk_expanded_t *const EPK,
+                                   const char *const m,
+                                   const uint64_t mlen,
+                                   const CROSS_sig_t *const sig,
+                                   const CROSS_executor_t *const exec){
+    uint8_t digest_msg[HASH_DIGEST_LENGTH];
+    hash(digest_msg, (uint8_t*) m, mlen, HASH_DOMAIN_SEP_CONST);
+    return verify_expanded_exec(EPK, digest_msg, sig, exec);
+}
+
+/* verifies n signatures against the same public key: results[i] is 1 if
+ * sig[i] is ok, 0 otherwise. Returns 1 if all signatures are ok.
+ * Only the derivation of digest_chall_1 and chall_1 is batched across
+ * signatures, the rounds of each signature are verified alone by
+ * verify_expanded_chall_1 */
+int CROSS_verify_batch(const pk_t *const PK,
+                       const size_t n,
+                       const char *const m[],
+                       const uint64_t mlen[],
+                       const CROSS_sig_t *const sig[],
+                       int results[]){
+    /* the public key is expanded once for the whole batch */
+    CROSS_pk_expanded_t EPK;
+    CROSS_pk_expand(PK,&EPK);
+
+    // Domain separation unique for expanding digest_chall_1
+    const uint16_t dsc_csprng_chall_1 = CSPRNG_DOMAIN_SEP_CONST + (3*T-1);
+    uint16_t dsc_hash[PAR_HASH_WAYS];
+    uint16_t dsc_csprng[PAR_HASH_WAYS];
+    for(int j = 0; j < PAR_HASH_WAYS; j++){
+        dsc_hash[j] = HASH_DOMAIN_SEP_CONST;
+        dsc_csprng[j] = dsc_csprng_chall_1;
+    }
+
+    int are_signatures_ok = 1;
+    /* the first challenges of PAR_HASH_WAYS signatures are derived side by
+     * side on the parallel Keccak, each signature is then verified alone */
+    for(size_t first = 0; first < n; first += PAR_HASH_WAYS){
+        const int par_level = (n-first < PAR_HASH_WAYS) ? (int)(n-first) : PAR_HASH_WAYS;
+        uint8_t digest_msg_cmt_salt[PAR_HASH_WAYS][2*HASH_DIGEST_LENGTH+SALT_LENGTH_BYTES];
+        uint8_t digest_chall_1[PAR_HASH_WAYS][HASH_DIGEST_LENGTH];
+        FP_ELEM chall_1[PAR_HASH_WAYS][T];
+        const unsigned char *inputs[PAR_HASH_WAYS] = {0};
+        uint8_t *digests[PAR_HASH_WAYS] = {0};
+        FP_ELEM *chall_1_ptrs[PAR_HASH_WAYS] = {0};
+
+        for(int j = 0; j < par_level; j++){
+            const CROSS_sig_t *const sig_j = sig[first+j];
+            /* messages differ in length, their digests are computed one by one */
+            hash(digest_msg_cmt_salt[j], (uint8_t*) m[first+j], mlen[first+j], HASH_DOMAIN_SEP_CONST);
+            memcpy(digest_msg_cmt_salt[j]+HASH_DIGEST_LENGTH, sig_j->digest_cmt, HASH_DIGEST_LENGTH);
+            memcpy(digest_msg_cmt_salt[j]+2*HASH_DIGEST_LENGTH, sig_j->salt, SALT_LENGTH_BYTES);
+            inputs[j] = digest_msg_cmt_salt[j];
+            digests[j] = digest_chall_1[j];
+            chall_1_ptrs[j] = chall_1[j];
+        }
+        hash_par8(par_level,
+                  digests,
+                  inputs,
+                  sizeof(digest_msg_cmt_salt[0]),
+                  dsc_hash);
+
+        for(int j = 0; j < par_level; j++){
+            inputs[j] = digest_chall_1[j];
+        }
+        PAR8_CSPRNG_STATE_T csprng_states;
+        csprng_initialize_par8(par_level,
+                               &csprng_states,
+                               inputs,
+                               sizeof(digest_chall_1[0]),
+                               dsc_csprng);
+        csprng_fp_vec_chall_1_par8(par_level, chall_1_ptrs, &csprng_states);
+
+        for(int j = 0; j < par_level; j++){
+            results[first+j] = verify_expanded_chall_1(&EPK,
+                                                       digest_chall_1[j],
+                                                       chall_1[j],
+                                                       sig[first+j],
+                                                       NULL);
+            are_signatures_ok = are_signatures_ok && results[first+j];
+        }
+    }
+    return are_signatures_ok;
+}
+
+void CROSS_sign_init(CROSS_sign_ctx_t *const ctx){
+    hash_init(&ctx->msg_state);
+}
+
+void CROSS_sign_update(CROSS_sign_ctx_t *const ctx,
+                       const char *const m,
+                       const uint64_t mlen){
+    hash_update(&ctx->msg_state, (const uint8_t*) m, mlen);
+}
+
+/* sign cannot fail */
+void CROSS_sign_final(CROSS_sign_ctx_t *const ctx,
+                      const sk_t *const SK,
+                      CROSS_sig_t *const sig){
+    uint8_t digest_msg[HASH_DIGEST_LENGTH];
+    hash_final(digest_msg, &ctx->msg_state, HASH_DOMAIN_SEP_CONST);
+    CROSS_sk_expanded_t ESK;
+    CROSS_sk_expand(SK,&ESK);
+    CROSS_sign_scratch_t ws;
+    sign_expanded_exec(&ESK, digest_msg, sig, NULL, &ws);
+    CROSS_sk_expanded_zeroize(&ESK);
+}
+
+void CROSS_verify_init(CROSS_verify_ctx_t *const ctx){
+    hash_init(&ctx->msg_state);
+}
+
+void CROSS_verify_update(CROSS_verify_ctx_t *const ctx,
+                         const char *const m,
+                         const uint64_t mlen){
+    hash_update(&ctx->msg_state, (const uint8_t*) m, mlen);
+}
+
+/* verify returns 1 if signature is ok, 0 otherwise */
+int CROSS_verify_final(CROSS_verify_ctx_t *const ctx,
+                       const pk_t *const PK,
+                       const CROSS_sig_t *const sig){
+    uint8_t digest_msg[HASH_DIGEST_LENGTH];
+    hash_final(digest_msg, &ctx->msg_state, HASH_DOMAIN_SEP_CONST);
+    CROSS_pk_expanded_t EPK;
+    CROSS_pk_expand(PK,&EPK);
+    return verify_expanded_exec(&EPK, digest_msg, sig, NULL);
+}
@@ -0,0 +1,263 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.2 (July 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Abstract:
+ *
+ * SSE implementation of the Keccak-p[1600] permutation, two instances at
+ * a time. When AVX-512VL is available, rotations employ vprolq and the
+ * theta and chi steps are computed with ternary logic instructions.
+ *
+ **/
+
+#include "architecture_detect.h"
+#if defined(HIGH_PERFORMANCE_X86_64)
+
+#include <stdint.h>
+#include <string.h>
+
+#include "KeccakP-1600-times2-SnP.h"
+#include "keccakf1600.h"
+
+static const uint64_t KeccakF1600RoundConstants[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL,
+    0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL,
+    0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL,
+    0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL,
+    0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+#if defined(HIGH_PERFORMANCE_X86_64_AVX512)
+/* ternary logic truth tables: a^b^c and a^(~b&c) */
+#define XOR5(a, b, c, d, e) _mm_ternarylogic_epi64(_mm_ternarylogic_epi64(a, b, c, 0x96), d, e, 0x96)
+#define CHI(a, b, c) _mm_ternarylogic_epi64(a, b, c, 0xD2)
+#define ROL64(a, o) _mm_rol_epi64(a, o)
+#else
+#define XOR5(a, b, c, d, e) _mm_xor_si128(_mm_xor_si128(_mm_xor_si128(a, b), _mm_xor_si128(c, d)), e)
+#define CHI(a, b, c) _mm_xor_si128(a, _mm_andnot_si128(b, c))
+/* rotations by a multiple of eight are byte shuffles */
+#define ROL64(a, o) ((o) == 8  ? _mm_shuffle_epi8(a, rho8) : \
+                     (o) == 56 ? _mm_shuffle_epi8(a, rho56) : \
+                     _mm_or_si128(_mm_slli_epi64(a, o), _mm_srli_epi64(a, 64-(o))))
+#endif
+
+/* one round on the 25 lanes A0...A24, lane (x,y) being A(x+5y): theta, rho
+ * and pi into B0...B24, where lane (x,y) moves to (y,2x+3y), then chi and
+ * iota back into A0...A24 */
+#define KECCAK_X2_ROUND(rc) \
+    do { \
+        C0 = XOR5(A0, A5, A10, A15, A20); \
+        C1 = XOR5(A1, A6, A11, A16, A21); \
+        C2 = XOR5(A2, A7, A12, A17, A22); \
+        C3 = XOR5(A3, A8, A13, A18, A23); \
+        C4 = XOR5(A4, A9, A14, A19, A24); \
+        D0 = _mm_xor_si128(C4, ROL64(C1, 1)); \
+        D1 = _mm_xor_si128(C0, ROL64(C2, 1)); \
+        D2 = _mm_xor_si128(C1, ROL64(C3, 1)); \
+        D3 = _mm_xor_si128(C2, ROL64(C4, 1)); \
+        D4 = _mm_xor_si128(C3, ROL64(C0, 1)); \
+        B0 = _mm_xor_si128(A0, D0); \
+        B10 = ROL64(_mm_xor_si128(A1, D1), 1); \
+        B20 = ROL64(_mm_xor_si128(A2, D2), 62); \
+        B5 = ROL64(_mm_xor_si128(A3, D3), 28); \
+        B15 = ROL64(_mm_xor_si128(A4, D4), 27); \
+        B16 = ROL64(_mm_xor_si128(A5, D0), 36); \
+        B1 = ROL64(_mm_xor_si128(A6, D1), 44); \
+        B11 = ROL64(_mm_xor_si128(A7, D2), 6); \
+        B21 = ROL64(_mm_xor_si128(A8, D3), 55); \
+        B6 = ROL64(_mm_xor_si128(A9, D4), 20); \
+        B7 = ROL64(_mm_xor_si128(A10, D0), 3); \
+        B17 = ROL64(_mm_xor_si128(A11, D1), 10); \
+        B2 = ROL64(_mm_xor_si128(A12, D2), 43); \
+        B12 = ROL64(_mm_xor_si128(A13, D3), 25); \
+        B22 = ROL64(_mm_xor_si128(A14, D4), 39); \
+        B23 = ROL64(_mm_xor_si128(A15, D0), 41); \
+        B8 = ROL64(_mm_xor_si128(A16, D1), 45); \
+        B18 = ROL64(_mm_xor_si128(A17, D2), 15); \
+        B3 = ROL64(_mm_xor_si128(A18, D3), 21); \
+        B13 = ROL64(_mm_xor_si128(A19, D4), 8); \
+        B14 = ROL64(_mm_xor_si128(A20, D0), 18); \
+        B24 = ROL64(_mm_xor_si128(A21, D1), 2); \
+        B9 = ROL64(_mm_xor_si128(A22, D2), 61); \
+        B19 = ROL64(_mm_xor_si128(A23, D3), 56); \
+        B4 = ROL64(_mm_xor_si128(A24, D4), 14); \
+        A0 = CHI(B0, B1, B2); \
+        A1 = CHI(B1, B2, B3); \
+        A2 = CHI(B2, B3, B4); \
+        A3 = CHI(B3, B4, B0); \
+        A4 = CHI(B4, B0, B1); \
+        A5 = CHI(B5, B6, B7); \
+        A6 = CHI(B6, B7, B8); \
+        A7 = CHI(B7, B8, B9); \
+        A8 = CHI(B8, B9, B5); \
+        A9 = CHI(B9, B5, B6); \
+        A10 = CHI(B10, B11, B12); \
+        A11 = CHI(B11, B12, B13); \
+        A12 = CHI(B12, B13, B14); \
+        A13 = CHI(B13, B14, B10); \
+        A14 = CHI(B14, B10, B11); \
+        A15 = CHI(B15, B16, B17); \
+        A16 = CHI(B16, B17, B18); \
+        A17 = CHI(B17, B18, B19); \
+        A18 = CHI(B18, B19, B15); \
+        A19 = CHI(B19, B15, B16); \
+        A20 = CHI(B20, B21, B22); \
+        A21 = CHI(B21, B22, B23); \
+        A22 = CHI(B22, B23, B24); \
+        A23 = CHI(B23, B24, B20); \
+        A24 = CHI(B24, B20, B21); \
+        A0 = _mm_xor_si128(A0, _mm_set1_epi64x((long long)(rc))); \
+    } while(0)
+
+void KeccakP1600times2_InitializeAll(KeccakP1600times2_states *states)
+{
+    memset(states, 0, sizeof(KeccakP1600times2_states));
+}
+
+void KeccakP1600times2_AddBytes(KeccakP1600times2_states *states, unsigned int instanceIndex, const unsigned char *data, unsigned int offset, unsigned int length)
+{
+    uint8_t *stateAsBytes = (uint8_t *)states->A;
+    for(unsigned int i = 0; i < length; i++) {
+        unsigned int pos = offset + i;
+        stateAsBytes[16*(pos/8) + 8*instanceIndex + pos%8] ^= data[i];
+    }
+}
+
+void KeccakP1600times2_AddLanesSeparate(KeccakP1600times2_states *states, const unsigned char *data0, const unsigned char *data1, unsigned int laneCount)
+{
+    unsigned int i = 0;
+    /* pairs of lanes are loaded with one access per instance and
+     * transposed with a single unpack */
+    for(; i+2 <= laneCount; i += 2) {
+        __m128i l0 = _mm_loadu_si128((const __m128i *) (data0 + 8*i));
+        __m128i l1 = _mm_loadu_si128((const __m128i *) (data1 + 8*i));
+        states->A[i]   = _mm_xor_si128(states->A[i],   _mm_unpacklo_epi64(l0, l1));
+        states->A[i+1] = _mm_xor_si128(states->A[i+1], _mm_unpackhi_epi64(l0, l1));
+    }
+    if(i < laneCount) {
+        __m128i l0 = _mm_loadl_epi64((const __m128i *) (data0 + 8*i));
+        __m128i l1 = _mm_loadl_epi64((const __m128i *) (data1 + 8*i));
+        states->A[i] = _mm_xor_si128(states->A[i], _mm_unpacklo_epi64(l0, l1));
+    }
+}
+
+void KeccakP1600times2_PermuteAll_24rounds(KeccakP1600times2_states *states)
+{
+    __m128i A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24;
+    __m128i B0, B1, B2, B3, B4, B5, B6, B7, B8, B9, B10, B11, B12, B13, B14, B15, B16, B17, B18, B19, B20, B21, B22, B23, B24;
+    __m128i C0, C1, C2, C3, C4, D0, D1, D2, D3, D4;
+
+    COUNT_KECCAK_PERMUTATION(2);
+#if !defined(HIGH_PERFORMANCE_X86_64_AVX512)
+    const __m128i rho8  = _mm_set_epi8(14, 13, 12, 11, 10, 9, 8, 15, 6, 5, 4, 3, 2, 1, 0, 7);
+    const __m128i rho56 = _mm_set_epi8(8, 15, 14, 13, 12, 11, 10, 9, 0, 7, 6, 5, 4, 3, 2, 1);
+#endif
+
+    A0 = _mm_loadu_si128(&states->A[0]);
+    A1 = _mm_loadu_si128(&states->A[1]);
+    A2 = _mm_loadu_si128(&states->A[2]);
+    A3 = _mm_loadu_si128(&states->A[3]);
+    A4 = _mm_loadu_si128(&states->A[4]);
+    A5 = _mm_loadu_si128(&states->A[5]);
+    A6 = _mm_loadu_si128(&states->A[6]);
+    A7 = _mm_loadu_si128(&states->A[7]);
+    A8 = _mm_loadu_si128(&states->A[8]);
+    A9 = _mm_loadu_si128(&states->A[9]);
+    A10 = _mm_loadu_si128(&states->A[10]);
+    A11 = _mm_loadu_si128(&states->A[11]);
+    A12 = _mm_loadu_si128(&states->A[12]);
+    A13 = _mm_loadu_si128(&states->A[13]);
+    A14 = _mm_loadu_si128(&states->A[14]);
+    A15 = _mm_loadu_si128(&states->A[15]);
+    A16 = _mm_loadu_si128(&states->A[16]);
+    A17 = _mm_loadu_si128(&states->A[17]);
+    A18 = _mm_loadu_si128(&states->A[18]);
+    A19 = _mm_loadu_si128(&states->A[19]);
+    A20 = _mm_loadu_si128(&states->A[20]);
+    A21 = _mm_loadu_si128(&states->A[21]);
+    A22 = _mm_loadu_si128(&states->A[22]);
+    A23 = _mm_loadu_si128(&states->A[23]);
+    A24 = _mm_loadu_si128(&states->A[24]);
+    for(int round = 0; round < 24; round++) {
+        KECCAK_X2_ROUND(KeccakF1600RoundConstants[round]);
+    }
+    _mm_storeu_si128(&states->A[0], A0);
+    _mm_storeu_si128(&states->A[1], A1);
+    _mm_storeu_si128(&states->A[2], A2);
+    _mm_storeu_si128(&states->A[3], A3);
+    _mm_storeu_si128(&states->A[4], A4);
+    _mm_storeu_si128(&states->A[5], A5);
+    _mm_storeu_si128(&states->A[6], A6);
+    _mm_storeu_si128(&states->A[7], A7);
+    _mm_storeu_si128(&states->A[8], A8);
+    _mm_storeu_si128(&states->A[9], A9);
+    _mm_storeu_si128(&states->A[10], A10);
+    _mm_storeu_si128(&states->A[11], A11);
+    _mm_storeu_si128(&states->A[12], A12);
+    _mm_storeu_si128(&states->A[13], A13);
+    _mm_storeu_si128(&states->A[14], A14);
+    _mm_storeu_si128(&states->A[15], A15);
+    _mm_storeu_si128(&states->A[16], A16);
+    _mm_storeu_si128(&states->A[17], A17);
+    _mm_storeu_si128(&states->A[18], A18);
+    _mm_storeu_si128(&states->A[19], A19);
+    _mm_storeu_si128(&states->A[20], A20);
+    _mm_storeu_si128(&states->A[21], A21);
+    _mm_storeu_si128(&states->A[22], A22);
+    _mm_storeu_si128(&states->A[23], A23);
+    _mm_storeu_si128(&states->A[24], A24);
+}
+
+void KeccakP1600times2_ExtractBytes(const KeccakP1600times2_states *states, unsigned int instanceIndex, unsigned char *data, unsigned int offset, unsigned int length)
+{
+    const uint8_t *stateAsBytes = (const uint8_t *)states->A;
+    for(unsigned int i = 0; i < length; i++) {
+        unsigned int pos = offset + i;
+        data[i] = stateAsBytes[16*(pos/8) + 8*instanceIndex + pos%8];
+    }
+}
+
+void KeccakP1600times2_ExtractLanesSeparate(const KeccakP1600times2_states *states, unsigned char *data0, unsigned char *data1, unsigned int laneCount)
+{
+    unsigned int i = 0;
+    for(; i+2 <= laneCount; i += 2) {
+        __m128i l0 = _mm_unpacklo_epi64(states->A[i], states->A[i+1]);
+        __m128i l1 = _mm_unpackhi_epi64(states->A[i], states->A[i+1]);
+        _mm_storeu_si128((__m128i *) (data0 + 8*i), l0);
+        _mm_storeu_si128((__m128i *) (data1 + 8*i), l1);
+    }
+    if(i < laneCount) {
+        _mm_storel_epi64((__m128i *) (data0 + 8*i), states->A[i]);
+        _mm_storel_epi64((__m128i *) (data1 + 8*i), _mm_unpackhi_epi64(states->A[i], states->A[i]));
+    }
+}
+
+#endif
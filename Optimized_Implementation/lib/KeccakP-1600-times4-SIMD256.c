@@ -30,6 +30,7 @@ Please refer to LowLevel.build for the exact list of other files it must be comb
 #include <emmintrin.h>
 #include "align.h"
 #include "KeccakP-1600-times4-SnP.h"
+#include "keccakf1600.h"
 #include "SIMD256-config.h"
 
 // #include "brg_endian.h"
@@ -128,13 +129,23 @@ void KeccakP1600times4_AddBytes(KeccakP1600times4_states *states, unsigned int i
 }
 
 void KeccakP1600times4_AddLanesAll(KeccakP1600times4_states *states, const unsigned char *data, unsigned int laneCount, unsigned int laneOffset)
+{
+    KeccakP1600times4_AddLanesSeparate(states,
+                                       data,
+                                       data+laneOffset*SnP_laneLengthInBytes,
+                                       data+laneOffset*2*SnP_laneLengthInBytes,
+                                       data+laneOffset*3*SnP_laneLengthInBytes,
+                                       laneCount);
+}
+
+void KeccakP1600times4_AddLanesSeparate(KeccakP1600times4_states *states, const unsigned char *data0, const unsigned char *data1, const unsigned char *data2, const unsigned char *data3, unsigned int laneCount)
 {
     V256 *stateAsLanes = states->A;
     unsigned int i;
-    const uint64_t *curData0 = (const uint64_t *)data;
-    const uint64_t *curData1 = (const uint64_t *)(data+laneOffset*SnP_laneLengthInBytes);
-    const uint64_t *curData2 = (const uint64_t *)(data+laneOffset*2*SnP_laneLengthInBytes);
-    const uint64_t *curData3 = (const uint64_t *)(data+laneOffset*3*SnP_laneLengthInBytes);
+    const uint64_t *curData0 = (const uint64_t *)data0;
+    const uint64_t *curData1 = (const uint64_t *)data1;
+    const uint64_t *curData2 = (const uint64_t *)data2;
+    const uint64_t *curData3 = (const uint64_t *)data3;
     V256    lanes0, lanes1, lanes2, lanes3, lanesL01, lanesL23, lanesH01, lanesH23;
 
     #define Xor_In( argIndex )  XOReq256(stateAsLanes[argIndex], LOAD4_64(curData3[argIndex], curData2[argIndex], curData1[argIndex], curData0[argIndex]))
@@ -297,10 +308,20 @@ void KeccakP1600times4_ExtractBytes(const KeccakP1600times4_states *states, unsi
 
 void KeccakP1600times4_ExtractLanesAll(const KeccakP1600times4_states *states, unsigned char *data, unsigned int laneCount, unsigned int laneOffset)
 {
-    uint64_t *curData0 = (uint64_t *)data;
-    uint64_t *curData1 = (uint64_t *)(data+laneOffset*1*SnP_laneLengthInBytes);
-    uint64_t *curData2 = (uint64_t *)(data+laneOffset*2*SnP_laneLengthInBytes);
-    uint64_t *curData3 = (uint64_t *)(data+laneOffset*3*SnP_laneLengthInBytes);
+    KeccakP1600times4_ExtractLanesSeparate(states,
+                                           data,
+                                           data+laneOffset*1*SnP_laneLengthInBytes,
+                                           data+laneOffset*2*SnP_laneLengthInBytes,
+                                           data+laneOffset*3*SnP_laneLengthInBytes,
+                                           laneCount);
+}
+
+void KeccakP1600times4_ExtractLanesSeparate(const KeccakP1600times4_states *states, unsigned char *data0, unsigned char *data1, unsigned char *data2, unsigned char *data3, unsigned int laneCount)
+{
+    uint64_t *curData0 = (uint64_t *)data0;
+    uint64_t *curData1 = (uint64_t *)data1;
+    uint64_t *curData2 = (uint64_t *)data2;
+    uint64_t *curData3 = (uint64_t *)data3;
 
     const V256 *stateAsLanes = states->A;
     const uint64_t *stateAsLanes64 = (const uint64_t*)states->A;
@@ -814,6 +835,8 @@ void KeccakP1600times4_PermuteAll_24rounds(KeccakP1600times4_states *states)
     unsigned int i;
     #endif
 
+    COUNT_KECCAK_PERMUTATION(4);
+
     copyFromState(A, statesAsLanes)
     rounds24
     copyToState(statesAsLanes, A)
@@ -0,0 +1,305 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.2 (July 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Abstract:
+ *
+ * AVX-512 implementation of the Keccak-p[1600] permutation, eight
+ * instances at a time. Rotations employ vprolq, the chi step is computed
+ * with a single ternary logic instruction per lane.
+ *
+ **/
+
+#include "architecture_detect.h"
+#if defined(HIGH_PERFORMANCE_X86_64_AVX512)
+
+#include <stdint.h>
+#include <string.h>
+
+#include "KeccakP-1600-times8-SnP.h"
+#include "keccakf1600.h"
+
+static const uint64_t KeccakF1600RoundConstants[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL,
+    0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL,
+    0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL,
+    0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL,
+    0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+/* ternary logic truth tables: a^b^c and a^(~b&c) */
+#define XOR3 0x96
+#define CHI  0xD2
+
+/* one round on the 25 lanes A0...A24, lane (x,y) being A(x+5y): theta, rho
+ * and pi into B0...B24, where lane (x,y) moves to (y,2x+3y), then chi and
+ * iota back into A0...A24 */
+#define KECCAK_X8_ROUND(rc) \
+    do { \
+        C0 = _mm512_ternarylogic_epi64(A0, A5, A10, XOR3); \
+        C0 = _mm512_ternarylogic_epi64(C0, A15, A20, XOR3); \
+        C1 = _mm512_ternarylogic_epi64(A1, A6, A11, XOR3); \
+        C1 = _mm512_ternarylogic_epi64(C1, A16, A21, XOR3); \
+        C2 = _mm512_ternarylogic_epi64(A2, A7, A12, XOR3); \
+        C2 = _mm512_ternarylogic_epi64(C2, A17, A22, XOR3); \
+        C3 = _mm512_ternarylogic_epi64(A3, A8, A13, XOR3); \
+        C3 = _mm512_ternarylogic_epi64(C3, A18, A23, XOR3); \
+        C4 = _mm512_ternarylogic_epi64(A4, A9, A14, XOR3); \
+        C4 = _mm512_ternarylogic_epi64(C4, A19, A24, XOR3); \
+        D0 = _mm512_xor_si512(C4, _mm512_rol_epi64(C1, 1)); \
+        D1 = _mm512_xor_si512(C0, _mm512_rol_epi64(C2, 1)); \
+        D2 = _mm512_xor_si512(C1, _mm512_rol_epi64(C3, 1)); \
+        D3 = _mm512_xor_si512(C2, _mm512_rol_epi64(C4, 1)); \
+        D4 = _mm512_xor_si512(C3, _mm512_rol_epi64(C0, 1)); \
+        B0 = _mm512_xor_si512(A0, D0); \
+        B10 = _mm512_rol_epi64(_mm512_xor_si512(A1, D1), 1); \
+        B20 = _mm512_rol_epi64(_mm512_xor_si512(A2, D2), 62); \
+        B5 = _mm512_rol_epi64(_mm512_xor_si512(A3, D3), 28); \
+        B15 = _mm512_rol_epi64(_mm512_xor_si512(A4, D4), 27); \
+        B16 = _mm512_rol_epi64(_mm512_xor_si512(A5, D0), 36); \
+        B1 = _mm512_rol_epi64(_mm512_xor_si512(A6, D1), 44); \
+        B11 = _mm512_rol_epi64(_mm512_xor_si512(A7, D2), 6); \
+        B21 = _mm512_rol_epi64(_mm512_xor_si512(A8, D3), 55); \
+        B6 = _mm512_rol_epi64(_mm512_xor_si512(A9, D4), 20); \
+        B7 = _mm512_rol_epi64(_mm512_xor_si512(A10, D0), 3); \
+        B17 = _mm512_rol_epi64(_mm512_xor_si512(A11, D1), 10); \
+        B2 = _mm512_rol_epi64(_mm512_xor_si512(A12, D2), 43); \
+        B12 = _mm512_rol_epi64(_mm512_xor_si512(A13, D3), 25); \
+        B22 = _mm512_rol_epi64(_mm512_xor_si512(A14, D4), 39); \
+        B23 = _mm512_rol_epi64(_mm512_xor_si512(A15, D0), 41); \
+        B8 = _mm512_rol_epi64(_mm512_xor_si512(A16, D1), 45); \
+        B18 = _mm512_rol_epi64(_mm512_xor_si512(A17, D2), 15); \
+        B3 = _mm512_rol_epi64(_mm512_xor_si512(A18, D3), 21); \
+        B13 = _mm512_rol_epi64(_mm512_xor_si512(A19, D4), 8); \
+        B14 = _mm512_rol_epi64(_mm512_xor_si512(A20, D0), 18); \
+        B24 = _mm512_rol_epi64(_mm512_xor_si512(A21, D1), 2); \
+        B9 = _mm512_rol_epi64(_mm512_xor_si512(A22, D2), 61); \
+        B19 = _mm512_rol_epi64(_mm512_xor_si512(A23, D3), 56); \
+        B4 = _mm512_rol_epi64(_mm512_xor_si512(A24, D4), 14); \
+        A0 = _mm512_ternarylogic_epi64(B0, B1, B2, CHI); \
+        A1 = _mm512_ternarylogic_epi64(B1, B2, B3, CHI); \
+        A2 = _mm512_ternarylogic_epi64(B2, B3, B4, CHI); \
+        A3 = _mm512_ternarylogic_epi64(B3, B4, B0, CHI); \
+        A4 = _mm512_ternarylogic_epi64(B4, B0, B1, CHI); \
+        A5 = _mm512_ternarylogic_epi64(B5, B6, B7, CHI); \
+        A6 = _mm512_ternarylogic_epi64(B6, B7, B8, CHI); \
+        A7 = _mm512_ternarylogic_epi64(B7, B8, B9, CHI); \
+        A8 = _mm512_ternarylogic_epi64(B8, B9, B5, CHI); \
+        A9 = _mm512_ternarylogic_epi64(B9, B5, B6, CHI); \
+        A10 = _mm512_ternarylogic_epi64(B10, B11, B12, CHI); \
+        A11 = _mm512_ternarylogic_epi64(B11, B12, B13, CHI); \
+        A12 = _mm512_ternarylogic_epi64(B12, B13, B14, CHI); \
+        A13 = _mm512_ternarylogic_epi64(B13, B14, B10, CHI); \
+        A14 = _mm512_ternarylogic_epi64(B14, B10, B11, CHI); \
+        A15 = _mm512_ternarylogic_epi64(B15, B16, B17, CHI); \
+        A16 = _mm512_ternarylogic_epi64(B16, B17, B18, CHI); \
+        A17 = _mm512_ternarylogic_epi64(B17, B18, B19, CHI); \
+        A18 = _mm512_ternarylogic_epi64(B18, B19, B15, CHI); \
+        A19 = _mm512_ternarylogic_epi64(B19, B15, B16, CHI); \
+        A20 = _mm512_ternarylogic_epi64(B20, B21, B22, CHI); \
+        A21 = _mm512_ternarylogic_epi64(B21, B22, B23, CHI); \
+        A22 = _mm512_ternarylogic_epi64(B22, B23, B24, CHI); \
+        A23 = _mm512_ternarylogic_epi64(B23, B24, B20, CHI); \
+        A24 = _mm512_ternarylogic_epi64(B24, B20, B21, CHI); \
+        A0 = _mm512_xor_si512(A0, _mm512_set1_epi64(rc)); \
+    } while(0)
+
+void KeccakP1600times8_InitializeAll(KeccakP1600times8_states *states)
+{
+    memset(states, 0, sizeof(KeccakP1600times8_states));
+}
+
+void KeccakP1600times8_AddBytes(KeccakP1600times8_states *states, unsigned int instanceIndex, const unsigned char *data, unsigned int offset, unsigned int length)
+{
+    uint8_t *stateAsBytes = (uint8_t *)states->A;
+    for(unsigned int i = 0; i < length; i++) {
+        unsigned int pos = offset + i;
+        stateAsBytes[64*(pos/8) + 8*instanceIndex + pos%8] ^= data[i];
+    }
+}
+
+/* transposes the 8x8 matrix of 64-bit elements held in r[0...7], turning
+ * eight consecutive lanes of the eight instances into eight state lanes, and
+ * vice versa */
+static inline
+void transpose_8x8_epi64(__m512i r[8])
+{
+    const __m512i idx_even = _mm512_setr_epi64(0, 1,  8,  9, 4, 5, 12, 13);
+    const __m512i idx_odd  = _mm512_setr_epi64(2, 3, 10, 11, 6, 7, 14, 15);
+    __m512i t[8], u[8];
+    for(int k = 0; k < 8; k += 2) {
+        t[k]   = _mm512_unpacklo_epi64(r[k], r[k+1]);
+        t[k+1] = _mm512_unpackhi_epi64(r[k], r[k+1]);
+    }
+    for(int k = 0; k < 8; k += 4) {
+        u[k]   = _mm512_permutex2var_epi64(t[k],   idx_even, t[k+2]);
+        u[k+1] = _mm512_permutex2var_epi64(t[k],   idx_odd,  t[k+2]);
+        u[k+2] = _mm512_permutex2var_epi64(t[k+1], idx_even, t[k+3]);
+        u[k+3] = _mm512_permutex2var_epi64(t[k+1], idx_odd,  t[k+3]);
+    }
+    r[0] = _mm512_shuffle_i64x2(u[0], u[4], 0x44);
+    r[4] = _mm512_shuffle_i64x2(u[0], u[4], 0xEE);
+    r[2] = _mm512_shuffle_i64x2(u[1], u[5], 0x44);
+    r[6] = _mm512_shuffle_i64x2(u[1], u[5], 0xEE);
+    r[1] = _mm512_shuffle_i64x2(u[2], u[6], 0x44);
+    r[5] = _mm512_shuffle_i64x2(u[2], u[6], 0xEE);
+    r[3] = _mm512_shuffle_i64x2(u[3], u[7], 0x44);
+    r[7] = _mm512_shuffle_i64x2(u[3], u[7], 0xEE);
+}
+
+void KeccakP1600times8_AddLanesSeparate(KeccakP1600times8_states *states, const unsigned char *const data[KECCAK_X8_INSTANCES], unsigned int laneCount)
+{
+    unsigned int i = 0;
+    /* blocks of eight lanes are loaded with one access per instance */
+    for(; i+8 <= laneCount; i += 8) {
+        __m512i r[8];
+        for(int instance = 0; instance < KECCAK_X8_INSTANCES; instance++) {
+            r[instance] = (data[instance] == NULL) ? _mm512_setzero_si512() :
+                          _mm512_loadu_si512((const void *) (data[instance] + 8*i));
+        }
+        transpose_8x8_epi64(r);
+        for(int k = 0; k < 8; k++) {
+            states->A[i+k] = _mm512_xor_si512(states->A[i+k], r[k]);
+        }
+    }
+    uint64_t *stateAsLanes64 = (uint64_t *)states->A;
+    for(unsigned int instance = 0; instance < KECCAK_X8_INSTANCES; instance++) {
+        if(data[instance] == NULL) {
+            continue;
+        }
+        for(unsigned int j = i; j < laneCount; j++) {
+            uint64_t lane;
+            memcpy(&lane, data[instance] + 8*j, 8);
+            stateAsLanes64[KECCAK_X8_INSTANCES*j + instance] ^= lane;
+        }
+    }
+}
+
+void KeccakP1600times8_PermuteAll_24rounds(KeccakP1600times8_states *states)
+{
+    __m512i A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16, A17, A18, A19, A20, A21, A22, A23, A24;
+    __m512i B0, B1, B2, B3, B4, B5, B6, B7, B8, B9, B10, B11, B12, B13, B14, B15, B16, B17, B18, B19, B20, B21, B22, B23, B24;
+    __m512i C0, C1, C2, C3, C4, D0, D1, D2, D3, D4;
+
+    COUNT_KECCAK_PERMUTATION(8);
+
+    A0 = _mm512_loadu_si512((const void *) &states->A[0]);
+    A1 = _mm512_loadu_si512((const void *) &states->A[1]);
+    A2 = _mm512_loadu_si512((const void *) &states->A[2]);
+    A3 = _mm512_loadu_si512((const void *) &states->A[3]);
+    A4 = _mm512_loadu_si512((const void *) &states->A[4]);
+    A5 = _mm512_loadu_si512((const void *) &states->A[5]);
+    A6 = _mm512_loadu_si512((const void *) &states->A[6]);
+    A7 = _mm512_loadu_si512((const void *) &states->A[7]);
+    A8 = _mm512_loadu_si512((const void *) &states->A[8]);
+    A9 = _mm512_loadu_si512((const void *) &states->A[9]);
+    A10 = _mm512_loadu_si512((const void *) &states->A[10]);
+    A11 = _mm512_loadu_si512((const void *) &states->A[11]);
+    A12 = _mm512_loadu_si512((const void *) &states->A[12]);
+    A13 = _mm512_loadu_si512((const void *) &states->A[13]);
+    A14 = _mm512_loadu_si512((const void *) &states->A[14]);
+    A15 = _mm512_loadu_si512((const void *) &states->A[15]);
+    A16 = _mm512_loadu_si512((const void *) &states->A[16]);
+    A17 = _mm512_loadu_si512((const void *) &states->A[17]);
+    A18 = _mm512_loadu_si512((const void *) &states->A[18]);
+    A19 = _mm512_loadu_si512((const void *) &states->A[19]);
+    A20 = _mm512_loadu_si512((const void *) &states->A[20]);
+    A21 = _mm512_loadu_si512((const void *) &states->A[21]);
+    A22 = _mm512_loadu_si512((const void *) &states->A[22]);
+    A23 = _mm512_loadu_si512((const void *) &states->A[23]);
+    A24 = _mm512_loadu_si512((const void *) &states->A[24]);
+    for(int round = 0; round < 24; round++) {
+        KECCAK_X8_ROUND(KeccakF1600RoundConstants[round]);
+    }
+    _mm512_storeu_si512((void *) &states->A[0], A0);
+    _mm512_storeu_si512((void *) &states->A[1], A1);
+    _mm512_storeu_si512((void *) &states->A[2], A2);
+    _mm512_storeu_si512((void *) &states->A[3], A3);
+    _mm512_storeu_si512((void *) &states->A[4], A4);
+    _mm512_storeu_si512((void *) &states->A[5], A5);
+    _mm512_storeu_si512((void *) &states->A[6], A6);
+    _mm512_storeu_si512((void *) &states->A[7], A7);
+    _mm512_storeu_si512((void *) &states->A[8], A8);
+    _mm512_storeu_si512((void *) &states->A[9], A9);
+    _mm512_storeu_si512((void *) &states->A[10], A10);
+    _mm512_storeu_si512((void *) &states->A[11], A11);
+    _mm512_storeu_si512((void *) &states->A[12], A12);
+    _mm512_storeu_si512((void *) &states->A[13], A13);
+    _mm512_storeu_si512((void *) &states->A[14], A14);
+    _mm512_storeu_si512((void *) &states->A[15], A15);
+    _mm512_storeu_si512((void *) &states->A[16], A16);
+    _mm512_storeu_si512((void *) &states->A[17], A17);
+    _mm512_storeu_si512((void *) &states->A[18], A18);
+    _mm512_storeu_si512((void *) &states->A[19], A19);
+    _mm512_storeu_si512((void *) &states->A[20], A20);
+    _mm512_storeu_si512((void *) &states->A[21], A21);
+    _mm512_storeu_si512((void *) &states->A[22], A22);
+    _mm512_storeu_si512((void *) &states->A[23], A23);
+    _mm512_storeu_si512((void *) &states->A[24], A24);
+}
+
+void KeccakP1600times8_ExtractBytes(const KeccakP1600times8_states *states, unsigned int instanceIndex, unsigned char *data, unsigned int offset, unsigned int length)
+{
+    const uint8_t *stateAsBytes = (const uint8_t *)states->A;
+    for(unsigned int i = 0; i < length; i++) {
+        unsigned int pos = offset + i;
+        data[i] = stateAsBytes[64*(pos/8) + 8*instanceIndex + pos%8];
+    }
+}
+
+void KeccakP1600times8_ExtractLanesSeparate(const KeccakP1600times8_states *states, unsigned char *const data[KECCAK_X8_INSTANCES], unsigned int laneCount)
+{
+    unsigned int i = 0;
+    /* blocks of eight lanes are stored with one access per instance */
+    for(; i+8 <= laneCount; i += 8) {
+        __m512i r[8];
+        for(int k = 0; k < 8; k++) {
+            r[k] = states->A[i+k];
+        }
+        transpose_8x8_epi64(r);
+        for(int instance = 0; instance < KECCAK_X8_INSTANCES; instance++) {
+            if(data[instance] != NULL) {
+                _mm512_storeu_si512((void *) (data[instance] + 8*i), r[instance]);
+            }
+        }
+    }
+    const uint64_t *stateAsLanes64 = (const uint64_t *)states->A;
+    for(unsigned int instance = 0; instance < KECCAK_X8_INSTANCES; instance++) {
+        if(data[instance] == NULL) {
+            continue;
+        }
+        for(unsigned int j = i; j < laneCount; j++) {
+            memcpy(data[instance] + 8*j, &stateAsLanes64[KECCAK_X8_INSTANCES*j + instance], 8);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,172 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.2 (July 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Abstract:
+ *
+ * Implementation of Keccak-p[1600] in parallel (x2) mode, following the
+ * structure of the x4 mode in fips202x4.c.
+ *
+ **/
+
+#include "architecture_detect.h"
+#if defined(HIGH_PERFORMANCE_X86_64)
+
+#include <stdint.h>
+
+#include "fips202x2.h"
+
+void keccak_x2_init(par2_keccak_context *ctx)
+{
+    KeccakP1600times2_InitializeAll(&ctx->state);
+    ctx->offset = 0;
+}
+
+void keccak_x2_absorb(par2_keccak_context *ctx, const unsigned char *in1, const unsigned char *in2, unsigned int in_len)
+{
+    /* the two inputs are read in place, no staging buffer is needed */
+    const unsigned char *ins[2] = {in1, in2};
+    /* if both these conditions are verified:
+     * - there are no bytes left from the previous input (offset == 0)
+     * - the new input size is a multiple of the lane size
+     * then absorb in parallel using AddLanesSeparate
+     * otherwise, absorb serially using AddBytes */
+    if(ctx->offset == 0 && in_len % (WORD / 8) == 0) {
+        int lanes = in_len * 8 / WORD;
+        while(lanes > 0) {
+            if(lanes >= MAX_LANES) {
+                KeccakP1600times2_AddLanesSeparate(&ctx->state, ins[0], ins[1], MAX_LANES);
+                KeccakP1600times2_PermuteAll_24rounds(&ctx->state);
+                lanes -= MAX_LANES;
+                for(int instance=0; instance<2; instance++) {
+                    ins[instance] += MAX_LANES * WORD / 8;
+                }
+                ctx->offset = 0;
+            } else {
+                KeccakP1600times2_AddLanesSeparate(&ctx->state, ins[0], ins[1], lanes);
+                ctx->offset = lanes * WORD / 8;
+                lanes = 0;
+            }
+        }
+    } else {
+        /* if there are enough bytes to fill the rate, absorb then permute */
+        while (in_len + ctx->offset >= RATE) {
+            for(int instance=0; instance<2; instance++) {
+                KeccakP1600times2_AddBytes(&ctx->state, instance, ins[instance], ctx->offset, RATE - ctx->offset);
+                ins[instance] += RATE - ctx->offset;
+            }
+            in_len -= RATE - ctx->offset;
+            KeccakP1600times2_PermuteAll_24rounds(&ctx->state);
+            ctx->offset = 0;
+        }
+        /* if there are any bytes left, absorb them */
+        for(int instance=0; instance<2; instance++) {
+            KeccakP1600times2_AddBytes(&ctx->state, instance, ins[instance], ctx->offset, in_len);
+        }
+        ctx->offset += in_len;
+    }
+}
+
+void keccak_x2_finalize(par2_keccak_context *ctx)
+{
+    /* add the domain separator */
+    uint8_t ds = DS;
+    if(ctx->offset == RATE - 1) {
+        ds |= 128;
+        for(int instance=0; instance<2; instance++) {
+            KeccakP1600times2_AddBytes(&ctx->state, instance, &ds, ctx->offset, 1);
+        }
+    } else {
+        for(int instance=0; instance<2; instance++) {
+            KeccakP1600times2_AddBytes(&ctx->state, instance, &ds, ctx->offset, 1);
+        }
+        ds = 128;
+        for(int instance=0; instance<2; instance++) {
+            KeccakP1600times2_AddBytes(&ctx->state, instance, &ds, RATE - 1, 1);
+        }
+    }
+    ctx->offset = 0;
+}
+
+void keccak_x2_squeeze(par2_keccak_context *ctx, unsigned char *out1, unsigned char *out2, unsigned int out_len)
+{
+    /* the two outputs are written in place, no staging buffer is needed */
+    unsigned char *outs[2] = {out1, out2};
+    /* if both these conditions are verified:
+     * - there are no bytes left from the previous extraction (offset == 0)
+     * - the new output size is a multiple of the lane size
+     * then extract in parallel using ExtractLanesSeparate
+     * otherwise, extract serially using ExtractBytes */
+    if(ctx->offset == 0 && out_len % (WORD / 8) == 0) {
+        int lanes = out_len * 8 / WORD;
+        while(lanes > 0) {
+            KeccakP1600times2_PermuteAll_24rounds(&ctx->state);
+            if(lanes >= MAX_LANES) {
+                KeccakP1600times2_ExtractLanesSeparate(&ctx->state, outs[0], outs[1], MAX_LANES);
+                lanes -= MAX_LANES;
+                for(int instance=0; instance<2; instance++) {
+                    outs[instance] += MAX_LANES * WORD / 8;
+                }
+                ctx->offset = 0;
+            } else {
+                KeccakP1600times2_ExtractLanesSeparate(&ctx->state, outs[0], outs[1], lanes);
+                ctx->offset = RATE - (lanes * WORD / 8);
+                lanes = 0;
+            }
+        }
+    } else {
+        int len;
+        if (out_len < ctx->offset) {
+            len = out_len;
+        } else {
+            len = ctx->offset;
+        }
+        for(int instance=0; instance<2; instance++) {
+            KeccakP1600times2_ExtractBytes(&ctx->state, instance, outs[instance], RATE - ctx->offset, len);
+            outs[instance] += len;
+        }
+        out_len -= len;
+        ctx->offset -= len;
+        while(out_len > 0) {
+            KeccakP1600times2_PermuteAll_24rounds(&ctx->state);
+            if(out_len < RATE) {
+                len = out_len;
+            } else {
+                len = RATE;
+            }
+            for(int instance=0; instance<2; instance++) {
+                KeccakP1600times2_ExtractBytes(&ctx->state, instance, outs[instance], 0, len);
+                outs[instance] += len;
+            }
+            out_len -= len;
+            ctx->offset = RATE - len;
+        }
+    }
+}
+
+#endif
@@ -46,10 +46,7 @@
 #include "architecture_detect.h"
 #if defined(HIGH_PERFORMANCE_X86_64)
 
-#include <assert.h>
 #include <stdint.h>
-#include <stdlib.h>
-#include <string.h>
 
 #include "fips202x4.h"
 
@@ -62,32 +59,26 @@ void keccak_x4_init(par_keccak_context *ctx)
 
 void keccak_x4_absorb(par_keccak_context *ctx, const unsigned char *in1, const unsigned char *in2, const unsigned char *in3, const unsigned char *in4, unsigned int in_len)
 {
-    /* allocate a signle buffer for all 4 inputs */
-    unsigned int total_len = 4 * in_len;
-    unsigned char *ins = (unsigned char *)malloc(total_len * sizeof(unsigned char));
-    assert(ins != NULL);
-    uint8_t* original_ins = ins; // to free the memory later
-    memcpy(ins, in1, in_len);
-    memcpy(ins + in_len, in2, in_len);
-    memcpy(ins + 2 * in_len, in3, in_len);
-    memcpy(ins + 3 * in_len, in4, in_len);
+    /* the four inputs are read in place, no staging buffer is needed */
+    const unsigned char *ins[4] = {in1, in2, in3, in4};
     /* if both these conditions are verified:
      * - there are no bytes left from the previous input (offset == 0)
      * - the new input size is a multiple of the lane size
-     * then absorb in parallel using AddLanesAll
+     * then absorb in parallel using AddLanesSeparate
      * otherwise, absorb serially using AddBytes */
     if(ctx->offset == 0 && in_len % (WORD / 8) == 0) {
         int lanes = in_len * 8 / WORD;
-        int lane_offset = lanes;
         while(lanes > 0) {
             if(lanes >= MAX_LANES) {
-                KeccakP1600times4_AddLanesAll(&ctx->state, ins, MAX_LANES, lane_offset);
+                KeccakP1600times4_AddLanesSeparate(&ctx->state, ins[0], ins[1], ins[2], ins[3], MAX_LANES);
                 KeccakP1600times4_PermuteAll_24rounds(&ctx->state);
                 lanes -= MAX_LANES;
-                ins += MAX_LANES * WORD / 8;
+                for(int instance=0; instance<4; instance++) {
+                    ins[instance] += MAX_LANES * WORD / 8;
+                }
                 ctx->offset = 0;
             } else {
-                KeccakP1600times4_AddLanesAll(&ctx->state, ins, lanes, lane_offset);
+                KeccakP1600times4_AddLanesSeparate(&ctx->state, ins[0], ins[1], ins[2], ins[3], lanes);
                 ctx->offset = lanes * WORD / 8;
                 lanes = 0;
             }
@@ -96,20 +87,19 @@ void keccak_x4_absorb(par_keccak_context *ctx, const unsigned char *in1, const u
         /* if there are enough bytes to fill the rate, absorb then permute */
         while (in_len + ctx->offset >= RATE) {
             for(int instance=0; instance<4; instance++) {
-                KeccakP1600times4_AddBytes(&ctx->state, instance, ins+instance*(total_len/4), ctx->offset, RATE - ctx->offset);
+                KeccakP1600times4_AddBytes(&ctx->state, instance, ins[instance], ctx->offset, RATE - ctx->offset);
+                ins[instance] += RATE - ctx->offset;
             }
             in_len -= RATE - ctx->offset;
-            ins += RATE - ctx->offset;
             KeccakP1600times4_PermuteAll_24rounds(&ctx->state);
             ctx->offset = 0;
         }
         /* if there are any bytes left, absorb them */
         for(int instance=0; instance<4; instance++) {
-            KeccakP1600times4_AddBytes(&ctx->state, instance, ins+instance*(total_len/4), ctx->offset, in_len);
+            KeccakP1600times4_AddBytes(&ctx->state, instance, ins[instance], ctx->offset, in_len);
         }
         ctx->offset += in_len;
     }
-    free(original_ins); 
 }
 
 void keccak_x4_finalize(par_keccak_context *ctx)
@@ -135,28 +125,26 @@ void keccak_x4_finalize(par_keccak_context *ctx)
 
 void keccak_x4_squeeze(par_keccak_context *ctx, unsigned char *out1, unsigned char *out2, unsigned char *out3, unsigned char *out4, unsigned int out_len)
 {
-    /* allocate a signle buffer for all 4 outputs */
-    unsigned int total_len = 4 * out_len;
-    unsigned char *outs = (unsigned char *)malloc(total_len * sizeof(unsigned char));
-    uint8_t* original_outs = outs; // to free the memory later
-    int original_out_len = out_len;
+    /* the four outputs are written in place, no staging buffer is needed */
+    unsigned char *outs[4] = {out1, out2, out3, out4};
     /* if both these conditions are verified:
      * - there are no bytes left from the previous extraction (offset == 0)
      * - the new output size is a multiple of the lane size
-     * then extract in parallel using ExtractLanesAll
+     * then extract in parallel using ExtractLanesSeparate
      * otherwise, extract serially using ExtractBytes */
     if(ctx->offset == 0 && out_len % (WORD / 8) == 0) {
         int lanes = out_len * 8 / WORD;
-        int lane_offset = lanes;
         while(lanes > 0) {
             KeccakP1600times4_PermuteAll_24rounds(&ctx->state);
             if(lanes >= MAX_LANES) {
-                KeccakP1600times4_ExtractLanesAll(&ctx->state, outs, MAX_LANES, lane_offset);
+                KeccakP1600times4_ExtractLanesSeparate(&ctx->state, outs[0], outs[1], outs[2], outs[3], MAX_LANES);
                 lanes -= MAX_LANES;
-                outs += MAX_LANES * WORD / 8;
+                for(int instance=0; instance<4; instance++) {
+                    outs[instance] += MAX_LANES * WORD / 8;
+                }
                 ctx->offset = 0;
             } else {
-                KeccakP1600times4_ExtractLanesAll(&ctx->state, outs, lanes, lane_offset);
+                KeccakP1600times4_ExtractLanesSeparate(&ctx->state, outs[0], outs[1], outs[2], outs[3], lanes);
                 ctx->offset = RATE - (lanes * WORD / 8);
                 lanes = 0;
             }
@@ -169,9 +157,9 @@ void keccak_x4_squeeze(par_keccak_context *ctx, unsigned char *out1, unsigned ch
             len = ctx->offset;
         }
         for(int instance=0; instance<4; instance++) {
-            KeccakP1600times4_ExtractBytes(&ctx->state, instance, outs+instance*(total_len/4), RATE - ctx->offset, len);
+            KeccakP1600times4_ExtractBytes(&ctx->state, instance, outs[instance], RATE - ctx->offset, len);
+            outs[instance] += len;
         }
-        outs += len;
         out_len -= len;
         ctx->offset -= len;
         while(out_len > 0) {
@@ -182,19 +170,13 @@ void keccak_x4_squeeze(par_keccak_context *ctx, unsigned char *out1, unsigned ch
                 len = RATE;
             }
             for(int instance=0; instance<4; instance++) {
-                KeccakP1600times4_ExtractBytes(&ctx->state, instance, outs+instance*(total_len/4), 0, len);
+                KeccakP1600times4_ExtractBytes(&ctx->state, instance, outs[instance], 0, len);
+                outs[instance] += len;
             }
-            outs += len;
             out_len -= len;
             ctx->offset = RATE - len;
         }
     }
-    memcpy(out1, original_outs, (total_len/4));
-    memcpy(out2, original_outs+original_out_len, (total_len/4));
-    memcpy(out3, original_outs+original_out_len*2, (total_len/4));
-    memcpy(out4, original_outs+original_out_len*3, (total_len/4));
-    free(original_outs);
-    
 }
 
 
@@ -0,0 +1,175 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.2 (July 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Abstract:
+ *
+ * Implementation of Keccak-p[1600] in parallel (x8) mode, following the
+ * structure of the x4 mode in fips202x4.c.
+ *
+ **/
+
+#include "architecture_detect.h"
+#if defined(HIGH_PERFORMANCE_X86_64_AVX512)
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "fips202x8.h"
+
+void keccak_x8_init(par8_keccak_context *ctx)
+{
+    KeccakP1600times8_InitializeAll(&ctx->state);
+    ctx->offset = 0;
+}
+
+void keccak_x8_absorb(par8_keccak_context *ctx, const unsigned char *const in[KECCAK_X8_INSTANCES], unsigned int in_len)
+{
+    const unsigned char *ins[KECCAK_X8_INSTANCES];
+    for(int instance=0; instance<KECCAK_X8_INSTANCES; instance++) {
+        ins[instance] = in[instance];
+    }
+    /* lane-wise absorption when no bytes are left from the previous input
+     * and the input size is a multiple of the lane size, bytewise otherwise */
+    if(ctx->offset == 0 && in_len % (WORD / 8) == 0) {
+        int lanes = in_len * 8 / WORD;
+        while(lanes > 0) {
+            if(lanes >= MAX_LANES) {
+                KeccakP1600times8_AddLanesSeparate(&ctx->state, ins, MAX_LANES);
+                KeccakP1600times8_PermuteAll_24rounds(&ctx->state);
+                lanes -= MAX_LANES;
+                for(int instance=0; instance<KECCAK_X8_INSTANCES; instance++) {
+                    if(ins[instance] != NULL) {
+                        ins[instance] += MAX_LANES * WORD / 8;
+                    }
+                }
+                ctx->offset = 0;
+            } else {
+                KeccakP1600times8_AddLanesSeparate(&ctx->state, ins, lanes);
+                ctx->offset = lanes * WORD / 8;
+                lanes = 0;
+            }
+        }
+    } else {
+        /* if there are enough bytes to fill the rate, absorb then permute */
+        while (in_len + ctx->offset >= RATE) {
+            for(int instance=0; instance<KECCAK_X8_INSTANCES; instance++) {
+                if(ins[instance] != NULL) {
+                    KeccakP1600times8_AddBytes(&ctx->state, instance, ins[instance], ctx->offset, RATE - ctx->offset);
+                    ins[instance] += RATE - ctx->offset;
+                }
+            }
+            in_len -= RATE - ctx->offset;
+            KeccakP1600times8_PermuteAll_24rounds(&ctx->state);
+            ctx->offset = 0;
+        }
+        /* if there are any bytes left, absorb them */
+        for(int instance=0; instance<KECCAK_X8_INSTANCES; instance++) {
+            if(ins[instance] != NULL) {
+                KeccakP1600times8_AddBytes(&ctx->state, instance, ins[instance], ctx->offset, in_len);
+            }
+        }
+        ctx->offset += in_len;
+    }
+}
+
+void keccak_x8_finalize(par8_keccak_context *ctx)
+{
+    /* add the domain separator and the final padding bit */
+    uint8_t ds = DS;
+    uint8_t last = 128;
+    for(int instance=0; instance<KECCAK_X8_INSTANCES; instance++) {
+        KeccakP1600times8_AddBytes(&ctx->state, instance, &ds, ctx->offset, 1);
+        KeccakP1600times8_AddBytes(&ctx->state, instance, &last, RATE - 1, 1);
+    }
+    ctx->offset = 0;
+}
+
+void keccak_x8_squeeze(par8_keccak_context *ctx, unsigned char *const out[KECCAK_X8_INSTANCES], unsigned int out_len)
+{
+    unsigned char *outs[KECCAK_X8_INSTANCES];
+    for(int instance=0; instance<KECCAK_X8_INSTANCES; instance++) {
+        outs[instance] = out[instance];
+    }
+    /* lane-wise extraction when no bytes are left from the previous
+     * extraction and the output size is a multiple of the lane size,
+     * bytewise otherwise */
+    if(ctx->offset == 0 && out_len % (WORD / 8) == 0) {
+        int lanes = out_len * 8 / WORD;
+        while(lanes > 0) {
+            KeccakP1600times8_PermuteAll_24rounds(&ctx->state);
+            if(lanes >= MAX_LANES) {
+                KeccakP1600times8_ExtractLanesSeparate(&ctx->state, outs, MAX_LANES);
+                lanes -= MAX_LANES;
+                for(int instance=0; instance<KECCAK_X8_INSTANCES; instance++) {
+                    if(outs[instance] != NULL) {
+                        outs[instance] += MAX_LANES * WORD / 8;
+                    }
+                }
+                ctx->offset = 0;
+            } else {
+                KeccakP1600times8_ExtractLanesSeparate(&ctx->state, outs, lanes);
+                ctx->offset = RATE - (lanes * WORD / 8);
+                lanes = 0;
+            }
+        }
+    } else {
+        unsigned int len;
+        if (out_len < ctx->offset) {
+            len = out_len;
+        } else {
+            len = ctx->offset;
+        }
+        for(int instance=0; instance<KECCAK_X8_INSTANCES; instance++) {
+            if(outs[instance] != NULL) {
+                KeccakP1600times8_ExtractBytes(&ctx->state, instance, outs[instance], RATE - ctx->offset, len);
+                outs[instance] += len;
+            }
+        }
+        out_len -= len;
+        ctx->offset -= len;
+        while(out_len > 0) {
+            KeccakP1600times8_PermuteAll_24rounds(&ctx->state);
+            if(out_len < RATE) {
+                len = out_len;
+            } else {
+                len = RATE;
+            }
+            for(int instance=0; instance<KECCAK_X8_INSTANCES; instance++) {
+                if(outs[instance] != NULL) {
+                    KeccakP1600times8_ExtractBytes(&ctx->state, instance, outs[instance], 0, len);
+                    outs[instance] += len;
+                }
+            }
+            out_len -= len;
+            ctx->offset = RATE - len;
+        }
+    }
+}
+
+#endif
@@ -159,8 +159,12 @@ void tree_root(uint8_t root[HASH_DIGEST_LENGTH],
 
     /* Enqueue the calls to hash */
     int to_hash = 0;
-    unsigned char* in_pos_queue[4] = {0};
-    int out_pos_queue[4] = {0};
+    const unsigned char* in_pos_queue[PAR_HASH_WAYS] = {0};
+    uint8_t* out_pos_queue[PAR_HASH_WAYS] = {0};
+    uint16_t dsc_queue[PAR_HASH_WAYS];
+    for (int j=0; j<PAR_HASH_WAYS; j++) {
+        dsc_queue[j] = HASH_DOMAIN_SEP_CONST;
+    }
 
     /* Start hashing the nodes from right to left, starting always with
      * the left-child node */
@@ -172,24 +176,14 @@ void tree_root(uint8_t root[HASH_DIGEST_LENGTH],
             uint16_t parent_node = PARENT(current_node) + (off[level-1] >> 1);
             /* Save the position of the hash outputs and copy input nodes into array */
             in_pos_queue[to_hash-1] = tree+current_node*HASH_DIGEST_LENGTH;
-            out_pos_queue[to_hash-1] = parent_node*HASH_DIGEST_LENGTH;            
-            /* Hash in batches of 4 (or less when changing tree level) */
-            if(to_hash == 4 || i == 0) {
-                hash_par(
-                    to_hash,
-                    tree + out_pos_queue[0],
-                    tree + out_pos_queue[1],
-                    tree + out_pos_queue[2],
-                    tree + out_pos_queue[3],
-                    in_pos_queue[0],
-                    in_pos_queue[1],
-                    in_pos_queue[2],
-                    in_pos_queue[3],
-                    2*HASH_DIGEST_LENGTH,
-                    HASH_DOMAIN_SEP_CONST,
-                    HASH_DOMAIN_SEP_CONST,
-                    HASH_DOMAIN_SEP_CONST,
-                    HASH_DOMAIN_SEP_CONST);
+            out_pos_queue[to_hash-1] = tree+parent_node*HASH_DIGEST_LENGTH;
+            /* Hash in batches of PAR_HASH_WAYS (or less when changing tree level) */
+            if(to_hash == PAR_HASH_WAYS || i == 0) {
+                hash_par8(to_hash,
+                          out_pos_queue,
+                          in_pos_queue,
+                          2*HASH_DIGEST_LENGTH,
+                          dsc_queue);
                 to_hash = 0;
             }
         }
@@ -257,8 +251,12 @@ uint8_t recompute_root(uint8_t root[HASH_DIGEST_LENGTH],
 
     /* Enqueue the calls to hash */
     int to_hash = 0;
-    int in_pos_queue[4] = {0};
-    int out_pos_queue[4] = {0};
+    const unsigned char* in_pos_queue[PAR_HASH_WAYS] = {0};
+    uint8_t* out_pos_queue[PAR_HASH_WAYS] = {0};
+    uint16_t dsc_queue[PAR_HASH_WAYS];
+    for (int j=0; j<PAR_HASH_WAYS; j++) {
+        dsc_queue[j] = HASH_DOMAIN_SEP_CONST;
+    }
 
     unsigned int published = 0;
     unsigned int start_node = leaves_start_indices[0];
@@ -272,8 +270,8 @@ uint8_t recompute_root(uint8_t root[HASH_DIGEST_LENGTH],
 
                 /* At least one of the siblings is valid: there is a hash to compute */
                 to_hash++;
-                in_pos_queue[to_hash-1] = current_node*HASH_DIGEST_LENGTH;
-                out_pos_queue[to_hash-1] = parent_node*HASH_DIGEST_LENGTH;
+                in_pos_queue[to_hash-1] = tree+current_node*HASH_DIGEST_LENGTH;
+                out_pos_queue[to_hash-1] = tree+parent_node*HASH_DIGEST_LENGTH;
 
                 /* If the left sibling was not computed take it from the merkle proof */
                 if (!(flag_tree[current_node] == COMPUTED)) {
@@ -290,23 +288,13 @@ uint8_t recompute_root(uint8_t root[HASH_DIGEST_LENGTH],
                 flag_tree[parent_node] = COMPUTED;
             }
 
-            /* Hash in batches of 4 (or less when changing tree level) */
-            if(to_hash == 4 || i == 0) {
-                hash_par(
-                    to_hash,
-                    tree + out_pos_queue[0],
-                    tree + out_pos_queue[1],
-                    tree + out_pos_queue[2],
-                    tree + out_pos_queue[3],
-                    tree + in_pos_queue[0],
-                    tree + in_pos_queue[1],
-                    tree + in_pos_queue[2],
-                    tree + in_pos_queue[3],
-                    2*HASH_DIGEST_LENGTH,
-                    HASH_DOMAIN_SEP_CONST,
-                    HASH_DOMAIN_SEP_CONST,
-                    HASH_DOMAIN_SEP_CONST,
-                    HASH_DOMAIN_SEP_CONST);
+            /* Hash in batches of PAR_HASH_WAYS (or less when changing tree level) */
+            if(to_hash == PAR_HASH_WAYS || i == 0) {
+                hash_par8(to_hash,
+                          out_pos_queue,
+                          in_pos_queue,
+                          2*HASH_DIGEST_LENGTH,
+                          dsc_queue);
                 to_hash = 0;
             }
         }
@@ -273,7 +273,7 @@ void gen_seed_tree(unsigned char seed_tree[NUM_NODES_SEED_TREE * SEED_LENGTH_BYT
                    const unsigned char root_seed[SEED_LENGTH_BYTES],
                    const unsigned char salt[SALT_LENGTH_BYTES])
 {
-    PAR_CSPRNG_STATE_T tree_csprng_state;
+    PAR8_CSPRNG_STATE_T tree_csprng_state;
 
     /* CSPRNG input: father seed | salt | father node index
      * CSPRNG output: left child seed | right child seed */
@@ -282,13 +282,15 @@ void gen_seed_tree(unsigned char seed_tree[NUM_NODES_SEED_TREE * SEED_LENGTH_BYT
 
     /* enqueue the calls to the CSPRNG */
     int to_expand = 0;
-    unsigned char in_queue[4][csprng_input_len];
-    uint16_t in_queue_dsc[4];
-    int out_pos_queue[4] = {0};
+    unsigned char in_queue[PAR_HASH_WAYS][csprng_input_len];
+    const unsigned char *in_pos_queue[PAR_HASH_WAYS];
+    uint16_t in_queue_dsc[PAR_HASH_WAYS];
+    unsigned char *out_pos_queue[PAR_HASH_WAYS] = {0};
 
-    /* copy the salt into all 4 CSPRNG inputs */
-    for(int i=0; i<4; i++){
+    /* copy the salt into all the CSPRNG inputs */
+    for(int i=0; i<PAR_HASH_WAYS; i++){
         memcpy(in_queue[i]+SEED_LENGTH_BYTES, salt, SALT_LENGTH_BYTES);
+        in_pos_queue[i] = in_queue[i];
     }
 
     /* Set the root seed in the tree from the received parameter */
@@ -320,32 +322,23 @@ void gen_seed_tree(unsigned char seed_tree[NUM_NODES_SEED_TREE * SEED_LENGTH_BYT
                     SEED_LENGTH_BYTES);
 
             /* save the position of the CSPRNG output (the left child) */
-            out_pos_queue[to_expand-1] = left_child_node*SEED_LENGTH_BYTES;  
+            out_pos_queue[to_expand-1] = seed_tree + left_child_node*SEED_LENGTH_BYTES;  
 
             /* add a domain separator to the CSPRNG input (the index of the father node) */
             in_queue_dsc[to_expand-1] = CSPRNG_DOMAIN_SEP_CONST + father_node;
 
-            /* call CSPRNG in batches of 4 (or less when changing tree level) */
-            if(to_expand == 4 || node_in_level == (npl[level]-lpl[level] - 1)) {
-                csprng_initialize_par(
-                    to_expand, 
-                    &tree_csprng_state, 
-                    in_queue[0],
-                    in_queue[1],
-                    in_queue[2],
-                    in_queue[3],
+            /* call CSPRNG in batches of PAR_HASH_WAYS (or less when changing tree level) */
+            if(to_expand == PAR_HASH_WAYS || node_in_level == (npl[level]-lpl[level] - 1)) {
+                csprng_initialize_par8(
+                    to_expand,
+                    &tree_csprng_state,
+                    in_pos_queue,
                     csprng_input_len,
-                    in_queue_dsc[0],
-                    in_queue_dsc[1],
-                    in_queue_dsc[2],
-                    in_queue_dsc[3]);
-                csprng_randombytes_par(
-                    to_expand, 
-                    &tree_csprng_state, 
-                    seed_tree + out_pos_queue[0],
-                    seed_tree + out_pos_queue[1],
-                    seed_tree + out_pos_queue[2],
-                    seed_tree + out_pos_queue[3],
+                    in_queue_dsc);
+                csprng_randombytes_par8(
+                    to_expand,
+                    &tree_csprng_state,
+                    out_pos_queue,
                     2*SEED_LENGTH_BYTES);
                 to_expand = 0;
             }
@@ -429,20 +422,22 @@ uint8_t rebuild_tree(unsigned char
     unsigned char flags_tree_to_publish[NUM_NODES_SEED_TREE] = {0};
     compute_seeds_to_publish(flags_tree_to_publish, indices_to_publish);
 
-    PAR_CSPRNG_STATE_T tree_csprng_state;
+    PAR8_CSPRNG_STATE_T tree_csprng_state;
 
     const uint32_t csprng_input_len = SALT_LENGTH_BYTES +
                                       SEED_LENGTH_BYTES;
 
     /* enqueue the calls to the CSPRNG */
     int to_expand = 0;
-    unsigned char in_queue[4][csprng_input_len];
-    uint16_t in_queue_dsc[4];
-    int out_pos_queue[4] = {0};
+    unsigned char in_queue[PAR_HASH_WAYS][csprng_input_len];
+    const unsigned char *in_pos_queue[PAR_HASH_WAYS];
+    uint16_t in_queue_dsc[PAR_HASH_WAYS];
+    unsigned char *out_pos_queue[PAR_HASH_WAYS] = {0};
 
-    /* copy the salt into all 4 CSPRNG inputs */
-    for(int i=0; i<4; i++){
+    /* copy the salt into all the CSPRNG inputs */
+    for(int i=0; i<PAR_HASH_WAYS; i++){
         memcpy(in_queue[i]+SEED_LENGTH_BYTES, salt, SALT_LENGTH_BYTES);
+        in_pos_queue[i] = in_queue[i];
     }
 
     const uint16_t off[LOG2(T)+1] = TREE_OFFSETS;
@@ -483,33 +478,24 @@ uint8_t rebuild_tree(unsigned char
                         SEED_LENGTH_BYTES);
 
                 /* save the position of the CSPRNG output (the left child) */
-                out_pos_queue[to_expand-1] = left_child*SEED_LENGTH_BYTES; 
+                out_pos_queue[to_expand-1] = seed_tree + left_child*SEED_LENGTH_BYTES; 
 
                 /* add a domain separator to the CSPRNG input (the index of the father node) */
                 in_queue_dsc[to_expand-1] = CSPRNG_DOMAIN_SEP_CONST + current_node;
             }
 
-            /* call CSPRNG in batches of 4 (or less when changing tree level) */
-            if(to_expand == 4 || node_in_level == (npl[level]-lpl[level] - 1)) {
-                csprng_initialize_par(
-                    to_expand, 
-                    &tree_csprng_state, 
-                    in_queue[0],
-                    in_queue[1],
-                    in_queue[2],
-                    in_queue[3],
+            /* call CSPRNG in batches of PAR_HASH_WAYS (or less when changing tree level) */
+            if(to_expand == PAR_HASH_WAYS || node_in_level == (npl[level]-lpl[level] - 1)) {
+                csprng_initialize_par8(
+                    to_expand,
+                    &tree_csprng_state,
+                    in_pos_queue,
                     csprng_input_len,
-                    in_queue_dsc[0],
-                    in_queue_dsc[1],
-                    in_queue_dsc[2],
-                    in_queue_dsc[3]);
-                csprng_randombytes_par(
-                    to_expand, 
-                    &tree_csprng_state, 
-                    seed_tree + out_pos_queue[0],
-                    seed_tree + out_pos_queue[1],
-                    seed_tree + out_pos_queue[2],
-                    seed_tree + out_pos_queue[3],
+                    in_queue_dsc);
+                csprng_randombytes_par8(
+                    to_expand,
+                    &tree_csprng_state,
+                    out_pos_queue,
                     2*SEED_LENGTH_BYTES);
                 to_expand = 0;
             }
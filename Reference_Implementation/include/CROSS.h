@@ -32,9 +32,16 @@
 #pragma once
 
 #include <stdint.h>
+#include <stddef.h>
 
+#include "CROSS_stats.h"
 #include "pack_unpack.h"
 #include "parameters.h"
+/* resolved through the include path, so that the layout of the implementation
+ * being compiled is picked, rather than the one next to this header */
+#include <matrix_layout.h>
+/* as above, for the SHAKE state of the implementation being compiled */
+#include <sha3.h>
 
 /* Public key: the parity check matrix is shrunk to a seed, syndrome
  * represented in full */
@@ -57,6 +64,68 @@ typedef struct {
 #endif
 } resp_0_t;
 
+/* Expanded public key: matrices expanded from the seed, in the layout
+ * employed by the arithmetic, and unpacked syndrome. Obtained once per key
+ * via CROSS_pk_expand, to be reused across verifications */
+typedef struct {
+   MATRIX_ALIGNAS V_TR_ELEM V_tr[K][V_TR_COLS];
+#if defined(RSDPG)
+   MATRIX_ALIGNAS W_MAT_ELEM W_mat[M][W_MAT_COLS];
+#endif
+   FP_ELEM s[N-K];
+   /* outcome of the padding check on the packed syndrome */
+   uint8_t is_padd_key_ok;
+} CROSS_pk_expanded_t;
+
+/* Expanded secret key, holds secret material: wipe it with
+ * CROSS_sk_expanded_zeroize once no longer needed */
+typedef struct {
+   MATRIX_ALIGNAS V_TR_ELEM V_tr[K][V_TR_COLS];
+#if defined(RSDPG)
+   MATRIX_ALIGNAS W_MAT_ELEM W_mat[M][W_MAT_COLS];
+   FZ_ELEM e_G_bar[M];
+#endif
+   FZ_ELEM e_bar[N];
+} CROSS_sk_expanded_t;
+
+/* Per round vectors, commitments and trees of a signature, which make up
+ * most of the memory employed in signing. The low memory schedule of the
+ * optimized implementation (LOW_MEMORY_SIGN) recomputes the per round
+ * vectors and absorbs cmt_1 and y on the fly instead of storing them */
+typedef struct {
+#if !defined(LOW_MEMORY_SIGN)
+   FZ_ELEM e_bar_prime[T][N];
+   FZ_ELEM v_bar[T][N];
+#if defined(RSDPG)
+   FZ_ELEM v_G_bar[T][M];
+#endif
+   FP_ELEM u_prime[T][N];
+   FP_ELEM y[T][N];
+#endif
+   FP_ELEM chall_1[T];
+   uint8_t cmt_0[T][HASH_DIGEST_LENGTH];
+#if !defined(LOW_MEMORY_SIGN)
+   uint8_t cmt_1[T*HASH_DIGEST_LENGTH];
+   uint8_t y_digest_chall_1[T*DENSELY_PACKED_FP_VEC_SIZE+HASH_DIGEST_LENGTH];
+#endif
+   uint8_t round_seeds[T*SEED_LENGTH_BYTES];
+#if !defined(NO_TREES)
+   uint8_t seed_tree[SEED_LENGTH_BYTES*NUM_NODES_SEED_TREE];
+   uint8_t merkle_tree[NUM_NODES_MERKLE_TREE*HASH_DIGEST_LENGTH];
+#endif
+} CROSS_sign_scratch_t;
+
+/* Scratch memory of CROSS_sign_ws, holds secret material */
+typedef struct {
+   CROSS_sk_expanded_t ESK;
+   CROSS_sign_scratch_t scratch;
+} CROSS_sign_workspace_t;
+
+/* bytes of scratch memory required by CROSS_sign_ws, including the slack to
+ * align a workspace starting at any address */
+#define CROSS_SIGN_WORKSPACE_BYTES (sizeof(CROSS_sign_workspace_t) + \
+                                    _Alignof(CROSS_sign_workspace_t) - 1)
+
 /* Signature: */
 typedef struct {
    uint8_t salt[SALT_LENGTH_BYTES];
@@ -76,6 +145,35 @@ typedef struct {
 } CROSS_sig_t;
 
 
+/* Executor for the threaded entry points, splitting the rounds of a
+ * signature among num_workers workers. If run is not NULL, it must call
+ * job(arg, w) once for each w in [0, num_workers), possibly concurrently,
+ * and return once all the calls have completed: this allows plugging in the
+ * thread pool of the caller. If run is NULL, POSIX threads are spawned when
+ * the optimized implementation is built with POSIX_THREADS defined, else
+ * the workers run one after the other in the calling thread.
+ * The output, resp. the verdict, is identical to the one of the single
+ * threaded functions.
+ * The reference implementation always runs single threaded */
+typedef struct {
+   int num_workers;
+   void (*run)(void *pool, void (*job)(void *arg, int worker), void *arg,
+               int num_workers);
+   void *pool;
+} CROSS_executor_t;
+
+/* Signing, resp. verification, of a message supplied in chunks: only the
+ * SHAKE state absorbing the message is kept, so that the memory employed
+ * does not depend on the message length. The signatures are the same as
+ * the ones of CROSS_sign and CROSS_verify on the whole message */
+typedef struct {
+   SHAKE_STATE_STRUCT msg_state;
+} CROSS_sign_ctx_t;
+
+typedef struct {
+   SHAKE_STATE_STRUCT msg_state;
+} CROSS_verify_ctx_t;
+
 /* keygen cannot fail */
 void CROSS_keygen(sk_t *SK,
                  pk_t *PK);
@@ -86,8 +184,106 @@ void CROSS_sign(const sk_t * const SK,
                 const uint64_t mlen,
                 CROSS_sig_t * const sig);
 
+/* sign employing the ws_len bytes at workspace as scratch memory in place
+ * of the stack, which is wiped before returning. Returns 1 on success, 0
+ * leaving sig untouched if ws_len is less than CROSS_SIGN_WORKSPACE_BYTES */
+int CROSS_sign_ws(const sk_t * const SK,
+                  const char * const m,
+                  const uint64_t mlen,
+                  CROSS_sig_t * const sig,
+                  void * const workspace,
+                  const size_t ws_len);
+
 /* verify returns 1 if signature is ok, 0 otherwise */
 int CROSS_verify(const pk_t * const PK,
                  const char * const m,
                  const uint64_t mlen,
                  const CROSS_sig_t * const sig);
+
+/* public key expansion cannot fail, padding errors in the syndrome are
+ * reported by CROSS_verify_expanded */
+void CROSS_pk_expand(const pk_t * const PK,
+                     CROSS_pk_expanded_t * const EPK);
+
+/* verify against an expanded public key, returns 1 if signature is ok,
+ * 0 otherwise */
+int CROSS_verify_expanded(const CROSS_pk_expanded_t * const EPK,
+                          const char * const m,
+                          const uint64_t mlen,
+                          const CROSS_sig_t * const sig);
+
+/* verify against an expanded public key, splitting the rounds among the
+ * workers of exec, returns 1 if signature is ok, 0 otherwise */
+int CROSS_verify_expanded_threaded(const CROSS_pk_expanded_t * const EPK,
+                                   const char * const m,
+                                   const uint64_t mlen,
+                                   const CROSS_sig_t * const sig,
+                                   const CROSS_executor_t * const exec);
+
+/* verify n signatures against the same public key, expanded only once:
+ * results[i] is 1 if sig[i] is ok on m[i], 0 otherwise. Returns 1 if all
+ * signatures are ok, 0 otherwise. The optimized implementation derives the
+ * first challenges of up to PAR_HASH_WAYS signatures side by side, the
+ * rounds of each signature are still verified one signature at a time */
+int CROSS_verify_batch(const pk_t * const PK,
+                       const size_t n,
+                       const char * const m[],
+                       const uint64_t mlen[],
+                       const CROSS_sig_t * const sig[],
+                       int results[]);
+
+/* secret key expansion cannot fail */
+void CROSS_sk_expand(const sk_t * const SK,
+                     CROSS_sk_expanded_t * const ESK);
+
+/* sign with an expanded secret key, cannot fail */
+void CROSS_sign_expanded(const CROSS_sk_expanded_t * const ESK,
+                         const char * const m,
+                         const uint64_t mlen,
+                         CROSS_sig_t * const sig);
+
+#if !defined(LOW_MEMORY_SIGN)
+/* sign with an expanded secret key, splitting the rounds among the workers
+ * of exec, cannot fail. Not provided with LOW_MEMORY_SIGN, as the low memory
+ * schedule computes the rounds one after the other in a single pass */
+void CROSS_sign_expanded_threaded(const CROSS_sk_expanded_t * const ESK,
+                                  const char * const m,
+                                  const uint64_t mlen,
+                                  CROSS_sig_t * const sig,
+                                  const CROSS_executor_t * const exec);
+#endif
+
+/* sign n messages with the same secret key, expanded only once, cannot
+ * fail */
+void CROSS_sign_batch(const sk_t * const SK,
+                      const size_t n,
+                      const char * const m[],
+                      const uint64_t mlen[],
+                      CROSS_sig_t * const sig[]);
+
+/* wipes the expanded secret key, the stores are not elided by the compiler */
+void CROSS_sk_expanded_zeroize(CROSS_sk_expanded_t * const ESK);
+
+/* streaming sign: init, then update with the chunks of the message in
+ * order, then final, which cannot fail */
+void CROSS_sign_init(CROSS_sign_ctx_t * const ctx);
+
+void CROSS_sign_update(CROSS_sign_ctx_t * const ctx,
+                       const char * const m,
+                       const uint64_t mlen);
+
+void CROSS_sign_final(CROSS_sign_ctx_t * const ctx,
+                      const sk_t * const SK,
+                      CROSS_sig_t * const sig);
+
+/* streaming verify: init, then update with the chunks of the message in
+ * order, then final, which returns 1 if signature is ok, 0 otherwise */
+void CROSS_verify_init(CROSS_verify_ctx_t * const ctx);
+
+void CROSS_verify_update(CROSS_verify_ctx_t * const ctx,
+                         const char * const m,
+                         const uint64_t mlen);
+
+int CROSS_verify_final(CROSS_verify_ctx_t * const ctx,
+                       const pk_t * const PK,
+                       const CROSS_sig_t * const sig);
@@ -0,0 +1,110 @@
+/**
+ *
+ * Reference ISO-C11 Implementation of CROSS.
+ *
+ * @version 2.2 (July 2025)
+ *
+ * Authors listed in alphabetical order:
+ * 
+ * @author: Alessandro Barenghi <alessandro.barenghi@polimi.it>
+ * @author: Marco Gianvecchio <marco.gianvecchio@mail.polimi.it>
+ * @author: Patrick Karl <patrick.karl@tum.de>
+ * @author: Gerardo Pelosi <gerardo.pelosi@polimi.it>
+ * @author: Jonas Schupp <jonas.schupp@tum.de>
+ * 
+ * 
+ * This code is hereby placed in the public domain.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHORS ''AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHORS OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Abstract: optional instrumentation of signature and verification,
+ * counting the Keccak permutations, the bytes absorbed and squeezed by
+ * SHAKE, and the cycles spent in each phase of the scheme. It is compiled
+ * in only when CROSS_STATS is defined, and it is not thread safe: the
+ * threaded entry points and concurrent calls yield unreliable counts.
+ *
+ **/
+
+#pragma once
+
+#include <stdint.h>
+
+/* phases of sign and verify, verification does not compute proofs and
+ * paths, and packs y within the round loop in the optimized code */
+typedef enum {
+   CROSS_PHASE_EXPAND_KEY,
+   CROSS_PHASE_SEED_TREE,
+   CROSS_PHASE_ROUNDS,
+   CROSS_PHASE_MERKLE_ROOT,
+   CROSS_PHASE_CHALL_1,
+   CROSS_PHASE_Y_PACKING,
+   CROSS_PHASE_CHALL_2,
+   CROSS_PHASE_PROOF_PATH,
+   CROSS_NUM_PHASES
+} CROSS_phase_t;
+
+/* counts accumulated since the last CROSS_stats_reset. Parallel calls
+ * permute, absorb and squeeze all their states, used or not. Timings are in
+ * cycles on x86-64, in nanoseconds elsewhere */
+typedef struct {
+   uint64_t keccak_calls_x1;
+   uint64_t keccak_calls_x2;
+   uint64_t keccak_calls_x4;
+   uint64_t keccak_calls_x8;
+   uint64_t bytes_absorbed;
+   uint64_t bytes_squeezed;
+   uint64_t phase_cycles[CROSS_NUM_PHASES];
+} CROSS_stats_t;
+
+void CROSS_stats_reset(void);
+void CROSS_stats_get(CROSS_stats_t *const stats);
+
+#if defined(CROSS_STATS)
+
+#if defined(__x86_64__)
+#include <x86intrin.h>
+static inline
+uint64_t CROSS_stats_timestamp(void){
+   return __rdtsc();
+}
+#else
+#include <time.h>
+static inline
+uint64_t CROSS_stats_timestamp(void){
+   struct timespec ts;
+   timespec_get(&ts, TIME_UTC);
+   return (uint64_t)ts.tv_sec*1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+extern CROSS_stats_t CROSS_stats;
+extern uint64_t CROSS_stats_phase_begin[CROSS_NUM_PHASES];
+
+#define COUNT_KECCAK_PERMUTATION(ways) (CROSS_stats.keccak_calls_x##ways++)
+#define COUNT_SHAKE_ABSORBED(bytes) (CROSS_stats.bytes_absorbed += (bytes))
+#define COUNT_SHAKE_SQUEEZED(bytes) (CROSS_stats.bytes_squeezed += (bytes))
+#define CROSS_STATS_PHASE_BEGIN(phase) \
+   (CROSS_stats_phase_begin[phase] = CROSS_stats_timestamp())
+#define CROSS_STATS_PHASE_END(phase) \
+   (CROSS_stats.phase_cycles[phase] += CROSS_stats_timestamp() - \
+                                       CROSS_stats_phase_begin[phase])
+
+#else
+
+#define COUNT_KECCAK_PERMUTATION(ways)
+#define COUNT_SHAKE_ABSORBED(bytes)
+#define COUNT_SHAKE_SQUEEZED(bytes)
+#define CROSS_STATS_PHASE_BEGIN(phase)
+#define CROSS_STATS_PHASE_END(phase)
+
+#endif
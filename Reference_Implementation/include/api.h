@@ -67,3 +67,28 @@ int crypto_sign_open(unsigned char *m,
                      unsigned long long smlen,
                      const unsigned char *pk
                     );
+
+/* detached signature: sig holds CRYPTO_BYTES bytes, the message is neither
+ * copied nor moved */
+int crypto_sign_signature(unsigned char *sig,
+                          unsigned long long *siglen,
+                          const unsigned char *m,
+                          unsigned long long mlen,
+                          const unsigned char *sk
+                         );
+
+int crypto_sign_verify(const unsigned char *sig,
+                       unsigned long long siglen,
+                       const unsigned char *m,
+                       unsigned long long mlen,
+                       const unsigned char *pk
+                      );
+
+/* open without copying the message out of the signed message: *m points
+ * into sm */
+int crypto_sign_open_inplace(const unsigned char **m,
+                             unsigned long long *mlen,
+                             const unsigned char *sm,
+                             unsigned long long smlen,
+                             const unsigned char *pk
+                            );
@@ -71,22 +71,53 @@ void randombytes(unsigned char * x,
 
 /************************* HASH functions ********************************/
 
+/* Incremental hashing, for inputs which are not available at once: the
+ * digest of a sequence of hash_update calls matches the one computed by
+ * hash on their concatenation */
+static inline
+void hash_init(CSPRNG_STATE_T * const hash_state){
+   /* SHAKE with a 2*lambda bit digest is employed also for hashing */
+   xof_shake_init(hash_state, SEED_LENGTH_BYTES*8);
+}
+
+/* the SHAKE wrappers take 32 bit lengths, longer inputs are absorbed in
+ * chunks */
+#define HASH_UPDATE_MAX_CHUNK_BYTES (1UL << 30)
+
+static inline
+void hash_update(CSPRNG_STATE_T * const hash_state,
+                 const unsigned char *m,
+                 uint64_t mlen){
+   while(mlen > HASH_UPDATE_MAX_CHUNK_BYTES){
+      xof_shake_update(hash_state,m,HASH_UPDATE_MAX_CHUNK_BYTES);
+      m += HASH_UPDATE_MAX_CHUNK_BYTES;
+      mlen -= HASH_UPDATE_MAX_CHUNK_BYTES;
+   }
+   xof_shake_update(hash_state,m,mlen);
+}
+
+static inline
+void hash_final(uint8_t digest[HASH_DIGEST_LENGTH],
+                CSPRNG_STATE_T * const hash_state,
+                const uint16_t dsc){
+   uint8_t dsc_ordered[2];
+   dsc_ordered[0] = dsc & 0xff;
+   dsc_ordered[1] = (dsc >> 8) & 0xff;
+   xof_shake_update(hash_state,dsc_ordered,2);
+   xof_shake_final(hash_state);
+   xof_shake_extract(hash_state,digest,HASH_DIGEST_LENGTH);
+}
+
 /* Opaque algorithm agnostic hash call */
 static inline
 void hash(uint8_t digest[HASH_DIGEST_LENGTH],
           const unsigned char *const m,
           const uint64_t mlen,
           const uint16_t dsc){
-   /* SHAKE with a 2*lambda bit digest is employed also for hashing */
-   CSPRNG_STATE_T csprng_state;    
-   xof_shake_init(&csprng_state, SEED_LENGTH_BYTES*8);
-   xof_shake_update(&csprng_state,m,mlen);
-   uint8_t dsc_ordered[2];
-   dsc_ordered[0] = dsc & 0xff;
-   dsc_ordered[1] = (dsc >> 8) & 0xff;
-   xof_shake_update(&csprng_state,dsc_ordered,2);
-   xof_shake_final(&csprng_state);    
-   xof_shake_extract(&csprng_state,digest,HASH_DIGEST_LENGTH);
+   CSPRNG_STATE_T csprng_state;
+   hash_init(&csprng_state);
+   hash_update(&csprng_state,m,mlen);
+   hash_final(digest,&csprng_state,dsc);
 }
 
 /***************** Specialized CSPRNGs for non binary domains *****************/
@@ -70,8 +70,31 @@
 
 #define FP_ELEM_CMOV(BIT,TRUE_V,FALSE_V)  ( (((FP_ELEM)0 - (BIT)) & (TRUE_V)) | (~((FP_ELEM)0 - (BIT)) & (FALSE_V)) )
 
+#if defined(RESTR_TO_VAL_TABLE)
+/* g^x is computed as g^(x mod 4) * g^(4*((x >> 2) mod 4)) * g^(16*(x >> 4)),
+ * the factors being read from tables of 16-bit entries packed in 64-bit
+ * words, indexed by shifts as RESTR_G_TABLE is for RSDP. The eight values of
+ * g^(16*i) span two words, selected with a mask. The product of the three
+ * factors is below 2^27, thus a single reduction is required */
+#define RESTR_G_TABLE_0     ((uint64_t) 0x0018010000100001)
+#define RESTR_G_TABLE_1     ((uint64_t) 0x01A1016301800001)
+#define RESTR_G_TABLE_2_LO  ((uint64_t) 0x005B005D012E0001)
+#define RESTR_G_TABLE_2_HI  ((uint64_t) 0x00910089013F01F9)
+
+static inline
+FP_ELEM RESTR_TO_VAL(FP_ELEM x){
+    uint64_t hi_mask = (uint64_t)0 - ((x >> 6) & 1);
+    uint64_t table_2 = (RESTR_G_TABLE_2_LO & ~hi_mask) |
+                       (RESTR_G_TABLE_2_HI & hi_mask);
+    uint32_t res0 = (uint16_t) (RESTR_G_TABLE_0 >> (16*(x & 3)));
+    uint32_t res1 = (uint16_t) (RESTR_G_TABLE_1 >> (16*((x >> 2) & 3)));
+    uint32_t res2 = (uint16_t) (table_2 >> (16*((x >> 4) & 3)));
+    return FPRED_SINGLE(res0 * res1 * res2);
+}
+#else
 /* log reduction, constant time unrolled S&M w/precomputed squares.
- * To be further optimized with muxed register-fitting tables */
+ * Compile with RESTR_TO_VAL_TABLE defined to employ the register-fitting
+ * tables above instead */
 static inline
 FP_ELEM RESTR_TO_VAL(FP_ELEM x){
     uint32_t res1, res2, res3, res4;
@@ -88,6 +111,7 @@ FP_ELEM RESTR_TO_VAL(FP_ELEM x){
      *     RESTR_G_GEN_16*RESTR_G_GEN_32*RESTR_G_GEN_64               < 2^32 */
     return FPRED_SINGLE( FPRED_SINGLE(res1 * res2) * FPRED_SINGLE(res3 * res4) );
 }
+#endif /* defined(RESTR_TO_VAL_TABLE) */
 
 #endif
 
@@ -38,3 +38,8 @@ void KeccakF1600_StateExtractBytes(uint64_t *state, unsigned char *data,
 void KeccakF1600_StateXORBytes(uint64_t *state, const unsigned char *data,
                                unsigned int offset, unsigned int length);
 void KeccakF1600_StatePermute(uint64_t *state);
+
+/* the calls to the permutation, split by the number of states permuted side
+ * by side, are counted in CROSS_stats when CROSS_STATS is defined. The
+ * permutations computed by libkeccak are not counted */
+#include "CROSS_stats.h"
@@ -36,7 +36,8 @@
 
 #include "parameters.h"
 
-/* compact Z_z/F_q vector encoding functions */
+/* compact Z_z/F_q vector encoding functions, the packing ones accept the
+ * redundant representation of zero of the arithmetic */
 
 void pack_fp_vec(uint8_t out[DENSELY_PACKED_FP_VEC_SIZE],
                  const FP_ELEM in[N]);
@@ -31,6 +31,8 @@
 
 #pragma once
 
+#include "CROSS_stats.h"
+
 #if defined(SHA_3_LIBKECCAK)
 #include <libkeccak.a.headers/KeccakHash.h>
 
@@ -53,6 +55,7 @@ void xof_shake_update(SHAKE_STATE_STRUCT *state,
                       const unsigned char *input,
                       unsigned int inputByteLen)
 {
+   COUNT_SHAKE_ABSORBED(inputByteLen);
    Keccak_HashUpdate(state,
                      (const BitSequence *) input,
                      (BitLength) inputByteLen*8 );
@@ -69,6 +72,7 @@ void xof_shake_extract(SHAKE_STATE_STRUCT *state,
                        unsigned char *output,
                        unsigned int outputByteLen)
 {
+   COUNT_SHAKE_SQUEEZED(outputByteLen);
    Keccak_HashSqueeze(state,
                       (BitSequence *) output,
                       (BitLength) outputByteLen*8 );
@@ -102,6 +106,7 @@ void xof_shake_update(SHAKE_STATE_STRUCT *state,
                       const unsigned char *input,
                       unsigned int inputByteLen)
 {
+   COUNT_SHAKE_ABSORBED(inputByteLen);
 #if defined(CATEGORY_1)
    shake128_inc_absorb(state,
                        (const uint8_t *)input,
@@ -127,6 +132,7 @@ static inline
 void xof_shake_extract(SHAKE_STATE_STRUCT *state,
                        unsigned char *output,
                        unsigned int outputByteLen){
+   COUNT_SHAKE_SQUEEZED(outputByteLen);
 #if defined(CATEGORY_1)
    shake128_inc_squeeze(output, outputByteLen, state);
 #else
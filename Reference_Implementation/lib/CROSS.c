@@ -40,6 +40,10 @@
 #include "pack_unpack.h"
 #include "seedtree.h"
 
+#if defined(LOW_MEMORY_SIGN)
+#error "The low memory signature schedule is provided by the optimized implementation only"
+#endif
+
 #if defined(RSDP)
 static
 void expand_pk(FP_ELEM V_tr[K][N-K],
@@ -70,6 +74,16 @@ void expand_pk(FP_ELEM V_tr[K][N-K],
 #endif
 
 
+/* clears sensitive buffers, the volatile access prevents the compiler from
+ * eliding the stores as dead */
+static
+void zeroize(void *const buf, const size_t len){
+    volatile uint8_t *p = (volatile uint8_t *) buf;
+    for(size_t i = 0; i < len; i++){
+        p[i] = 0;
+    }
+}
+
 #if defined(RSDP)
 static
 void expand_sk(FZ_ELEM e_bar[N],
@@ -95,6 +109,9 @@ void expand_sk(FZ_ELEM e_bar[N],
   CSPRNG_STATE_T csprng_state_e_bar;
   csprng_initialize(&csprng_state_e_bar, seed_e_seed_pk[0], KEYPAIR_SEED_LENGTH_BYTES, dsc_csprng_seed_e);
   csprng_fz_vec(e_bar,&csprng_state_e_bar);
+  zeroize(seed_e_seed_pk,sizeof(seed_e_seed_pk));
+  zeroize(&csprng_state,sizeof(csprng_state));
+  zeroize(&csprng_state_e_bar,sizeof(csprng_state_e_bar));
 }
 #elif defined(RSDPG)
 static
@@ -125,6 +142,9 @@ void expand_sk(FZ_ELEM e_bar[N],
   csprng_fz_inf_w(e_G_bar,&csprng_state_e_bar);
   fz_inf_w_by_fz_matrix(e_bar,e_G_bar,W_mat);
   fz_dz_norm_n(e_bar);
+  zeroize(seed_e_seed_pk,sizeof(seed_e_seed_pk));
+  zeroize(&csprng_state,sizeof(csprng_state));
+  zeroize(&csprng_state_e_bar,sizeof(csprng_state_e_bar));
 }
 #endif
 
@@ -178,42 +198,72 @@ void CROSS_keygen(sk_t *SK,
   pack_fp_syn(PK->s,s);
 }
 
+void CROSS_sk_expand(const sk_t *const SK,
+                     CROSS_sk_expanded_t *const ESK){
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_EXPAND_KEY);
+#if defined(RSDP)
+    expand_sk(ESK->e_bar,ESK->V_tr,SK->seed_sk);
+#elif defined(RSDPG)
+    expand_sk(ESK->e_bar,ESK->e_G_bar,ESK->V_tr,ESK->W_mat,SK->seed_sk);
+#endif
+    CROSS_STATS_PHASE_END(CROSS_PHASE_EXPAND_KEY);
+}
+
+void CROSS_sk_expanded_zeroize(CROSS_sk_expanded_t *const ESK){
+    zeroize(ESK,sizeof(CROSS_sk_expanded_t));
+}
+
 /* sign cannot fail */
 void CROSS_sign(const sk_t *SK,
                const char *const m,
                const uint64_t mlen,
                CROSS_sig_t *sig){
+    CROSS_sk_expanded_t ESK;
+    CROSS_sk_expand(SK,&ESK);
+    CROSS_sign_expanded(&ESK,m,mlen,sig);
+    CROSS_sk_expanded_zeroize(&ESK);
+}
+
+/* signs the message of digest digest_msg, keeping the per round values in
+ * ws, cannot fail */
+static
+void sign_expanded_digest_msg(const CROSS_sk_expanded_t *const ESK,
+                              const uint8_t digest_msg[HASH_DIGEST_LENGTH],
+                              CROSS_sig_t *sig,
+                              CROSS_sign_scratch_t *const ws){
     /* Wipe any residual information in the sig structure allocated by the 
      * caller */
     memset(sig,0,sizeof(CROSS_sig_t));
-    /* Key material expansion */
-    FP_ELEM V_tr[K][N-K];
-    FZ_ELEM e_bar[N];
-#if defined(RSDP)
-    expand_sk(e_bar,V_tr,SK->seed_sk);
-#elif defined(RSDPG)
-    FZ_ELEM e_G_bar[M];
-    FZ_ELEM W_mat[M][N-M];
-    expand_sk(e_bar,e_G_bar,V_tr,W_mat,SK->seed_sk);
+
+    /* the expanded key is constant, ISO C11 forbids const in the
+     * arithmetic function prototypes */
+    FP_ELEM (*V_tr)[N-K] = (FP_ELEM (*)[N-K]) ESK->V_tr;
+    FZ_ELEM *e_bar = (FZ_ELEM *) ESK->e_bar;
+#if defined(RSDPG)
+    FZ_ELEM (*W_mat)[N-M] = (FZ_ELEM (*)[N-M]) ESK->W_mat;
+    FZ_ELEM *e_G_bar = (FZ_ELEM *) ESK->e_G_bar;
 #endif
 
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_SEED_TREE);
     uint8_t root_seed[SEED_LENGTH_BYTES];
     randombytes(root_seed,SEED_LENGTH_BYTES);
     randombytes(sig->salt,SALT_LENGTH_BYTES);
 
+    uint8_t *round_seeds = ws->round_seeds;
+    memset(round_seeds,0,sizeof(ws->round_seeds));
 #if defined(NO_TREES)
-    unsigned char round_seeds[T*SEED_LENGTH_BYTES] = {0};
     seed_leaves(round_seeds,root_seed,sig->salt);
 #else
-    uint8_t seed_tree[SEED_LENGTH_BYTES*NUM_NODES_SEED_TREE] = {0};
+    uint8_t *seed_tree = ws->seed_tree;
+    memset(seed_tree,0,sizeof(ws->seed_tree));
     gen_seed_tree(seed_tree,root_seed,sig->salt);
-    unsigned char round_seeds[T*SEED_LENGTH_BYTES] = {0};
     seed_leaves(round_seeds, seed_tree);
 #endif
+    CROSS_STATS_PHASE_END(CROSS_PHASE_SEED_TREE);
 
-    FZ_ELEM e_bar_prime[T][N];
-    FZ_ELEM v_bar[T][N];
-    FP_ELEM u_prime[T][N];
+    FZ_ELEM (*e_bar_prime)[N] = ws->e_bar_prime;
+    FZ_ELEM (*v_bar)[N] = ws->v_bar;
+    FP_ELEM (*u_prime)[N] = ws->u_prime;
     FP_ELEM s_prime[N-K];
 
 #if defined(RSDP)
@@ -223,7 +273,7 @@ void CROSS_sign(const sk_t *SK,
     const int offset_salt = DENSELY_PACKED_FP_SYN_SIZE+DENSELY_PACKED_FZ_VEC_SIZE;
 #elif defined(RSDPG)
     FZ_ELEM e_G_bar_prime[M];
-    FZ_ELEM v_G_bar[T][M];
+    FZ_ELEM (*v_G_bar)[M] = ws->v_G_bar;
     uint8_t cmt_0_i_input[DENSELY_PACKED_FP_SYN_SIZE+
                           DENSELY_PACKED_FZ_RSDP_G_VEC_SIZE+
                           SALT_LENGTH_BYTES];
@@ -237,9 +287,12 @@ void CROSS_sign(const sk_t *SK,
     /* cmt_1_i_input is concat(seed,salt,round index + 2T-1) */
     memcpy(cmt_1_i_input+SEED_LENGTH_BYTES, sig->salt, SALT_LENGTH_BYTES);
 
-    uint8_t cmt_0[T][HASH_DIGEST_LENGTH] = {0};
-    uint8_t cmt_1[T*HASH_DIGEST_LENGTH] = {0};
+    uint8_t (*cmt_0)[HASH_DIGEST_LENGTH] = ws->cmt_0;
+    uint8_t *cmt_1 = ws->cmt_1;
+    memset(cmt_0,0,sizeof(ws->cmt_0));
+    memset(cmt_1,0,sizeof(ws->cmt_1));
 
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_ROUNDS);
     CSPRNG_STATE_T csprng_state;
     for(uint16_t i = 0; i<T; i++){
         /* CSPRNG is fed with concat(seed,salt,round index) represented
@@ -296,24 +349,28 @@ void CROSS_sign(const sk_t *SK,
         
         hash(&cmt_1[i*HASH_DIGEST_LENGTH], cmt_1_i_input, sizeof(cmt_1_i_input), domain_sep_hash);
     }
+    CROSS_STATS_PHASE_END(CROSS_PHASE_ROUNDS);
 
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_MERKLE_ROOT);
     /* vector containing d_0 and d_1 from spec */
     uint8_t digest_cmt0_cmt1[2*HASH_DIGEST_LENGTH];
 
 #if defined(NO_TREES)
     tree_root(digest_cmt0_cmt1, cmt_0);
 #else
-    uint8_t merkle_tree_0[NUM_NODES_MERKLE_TREE * HASH_DIGEST_LENGTH];
+    uint8_t *merkle_tree_0 = ws->merkle_tree;
     tree_root(digest_cmt0_cmt1, merkle_tree_0, cmt_0);
 #endif
-    hash(digest_cmt0_cmt1 + HASH_DIGEST_LENGTH, cmt_1, sizeof(cmt_1), HASH_DOMAIN_SEP_CONST);
+    hash(digest_cmt0_cmt1 + HASH_DIGEST_LENGTH, cmt_1, sizeof(ws->cmt_1), HASH_DOMAIN_SEP_CONST);
     hash(sig->digest_cmt, digest_cmt0_cmt1, sizeof(digest_cmt0_cmt1), HASH_DOMAIN_SEP_CONST);
+    CROSS_STATS_PHASE_END(CROSS_PHASE_MERKLE_ROOT);
 
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_CHALL_1);
     /* first challenge extraction */
     uint8_t digest_msg_cmt_salt[2*HASH_DIGEST_LENGTH+SALT_LENGTH_BYTES];
 
     /* place digest_msg at the beginning of the input of the hash generating digest_chall_1 */
-    hash(digest_msg_cmt_salt, (uint8_t*) m, mlen, HASH_DOMAIN_SEP_CONST);
+    memcpy(digest_msg_cmt_salt, digest_msg, HASH_DIGEST_LENGTH);
     memcpy(digest_msg_cmt_salt+HASH_DIGEST_LENGTH, sig->digest_cmt, HASH_DIGEST_LENGTH);
     memcpy(digest_msg_cmt_salt+2*HASH_DIGEST_LENGTH, sig->salt, SALT_LENGTH_BYTES);
 
@@ -323,12 +380,14 @@ void CROSS_sign(const sk_t *SK,
     // Domain separation unique for expanding chall_1
     const uint16_t dsc_csprng_chall_1 = CSPRNG_DOMAIN_SEP_CONST + (3*T-1);
 
-    FP_ELEM chall_1[T];
+    FP_ELEM *chall_1 = ws->chall_1;
     csprng_initialize(&csprng_state, digest_chall_1, sizeof(digest_chall_1), dsc_csprng_chall_1);
     csprng_fp_vec_chall_1(chall_1, &csprng_state);
+    CROSS_STATS_PHASE_END(CROSS_PHASE_CHALL_1);
 
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_Y_PACKING);
     /* Computation of the first round of responses */
-    FP_ELEM y[T][N];
+    FP_ELEM (*y)[N] = ws->y;
     for(int i = 0; i < T; i++){
         fp_vec_by_restr_vec_scaled(y[i],
                                    e_bar_prime[i],
@@ -337,19 +396,24 @@ void CROSS_sign(const sk_t *SK,
         fp_dz_norm(y[i]);
     }
     /* y vectors are packed before being hashed */
-    uint8_t y_digest_chall_1[T*DENSELY_PACKED_FP_VEC_SIZE+HASH_DIGEST_LENGTH];
+    uint8_t *y_digest_chall_1 = ws->y_digest_chall_1;
 
     for(int x = 0; x < T; x++){
         pack_fp_vec(y_digest_chall_1+(x*DENSELY_PACKED_FP_VEC_SIZE),y[x]);
     }
+    CROSS_STATS_PHASE_END(CROSS_PHASE_Y_PACKING);
+
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_CHALL_2);
     /* Second challenge extraction */
     memcpy(y_digest_chall_1+T*DENSELY_PACKED_FP_VEC_SIZE,digest_chall_1,HASH_DIGEST_LENGTH);
 
-    hash(sig->digest_chall_2, y_digest_chall_1, sizeof(y_digest_chall_1), HASH_DOMAIN_SEP_CONST);
+    hash(sig->digest_chall_2, y_digest_chall_1, sizeof(ws->y_digest_chall_1), HASH_DOMAIN_SEP_CONST);
 
     uint8_t chall_2[T]={0};
     expand_digest_to_fixed_weight(chall_2,sig->digest_chall_2);
+    CROSS_STATS_PHASE_END(CROSS_PHASE_CHALL_2);
 
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_PROOF_PATH);
     /* Computation of the second round of responses */
 #if defined(NO_TREES)
     tree_proof(sig->proof,cmt_0,chall_2);
@@ -373,6 +437,79 @@ void CROSS_sign(const sk_t *SK,
             published_rsps++;
         }
     }
+    CROSS_STATS_PHASE_END(CROSS_PHASE_PROOF_PATH);
+}
+
+/* sign cannot fail */
+void CROSS_sign_expanded(const CROSS_sk_expanded_t *const ESK,
+                         const char *const m,
+                         const uint64_t mlen,
+                         CROSS_sig_t *sig){
+    uint8_t digest_msg[HASH_DIGEST_LENGTH];
+    hash(digest_msg, (uint8_t*) m, mlen, HASH_DOMAIN_SEP_CONST);
+    CROSS_sign_scratch_t ws;
+    sign_expanded_digest_msg(ESK,digest_msg,sig,&ws);
+}
+
+int CROSS_sign_ws(const sk_t *const SK,
+                  const char *const m,
+                  const uint64_t mlen,
+                  CROSS_sig_t *const sig,
+                  void *const workspace,
+                  const size_t ws_len){
+    /* align the workspace, the slack is part of CROSS_SIGN_WORKSPACE_BYTES */
+    const uintptr_t align = _Alignof(CROSS_sign_workspace_t);
+    const uintptr_t start = (uintptr_t) workspace;
+    const uintptr_t aligned = (start + align - 1) & ~(align - 1);
+    if(workspace == NULL ||
+       ws_len < aligned - start ||
+       ws_len - (aligned - start) < sizeof(CROSS_sign_workspace_t)){
+        return 0;
+    }
+    CROSS_sign_workspace_t *ws = (CROSS_sign_workspace_t *) aligned;
+
+    CROSS_sk_expand(SK,&ws->ESK);
+    uint8_t digest_msg[HASH_DIGEST_LENGTH];
+    hash(digest_msg, (uint8_t*) m, mlen, HASH_DOMAIN_SEP_CONST);
+    sign_expanded_digest_msg(&ws->ESK,digest_msg,sig,&ws->scratch);
+    zeroize(ws,sizeof(CROSS_sign_workspace_t));
+    return 1;
+}
+
+/* the reference implementation runs single threaded */
+void CROSS_sign_expanded_threaded(const CROSS_sk_expanded_t *const ESK,
+                                  const char *const m,
+                                  const uint64_t mlen,
+                                  CROSS_sig_t *sig,
+                                  const CROSS_executor_t *const exec){
+    (void) exec;
+    CROSS_sign_expanded(ESK,m,mlen,sig);
+}
+
+/* signs n messages with the same secret key, expanded only once */
+void CROSS_sign_batch(const sk_t *const SK,
+                      const size_t n,
+                      const char *const m[],
+                      const uint64_t mlen[],
+                      CROSS_sig_t *const sig[]){
+    CROSS_sk_expanded_t ESK;
+    CROSS_sk_expand(SK,&ESK);
+    for(size_t i = 0; i < n; i++){
+        CROSS_sign_expanded(&ESK,m[i],mlen[i],sig[i]);
+    }
+    CROSS_sk_expanded_zeroize(&ESK);
+}
+
+void CROSS_pk_expand(const pk_t *const PK,
+                     CROSS_pk_expanded_t *const EPK){
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_EXPAND_KEY);
+#if defined(RSDP)
+    expand_pk(EPK->V_tr,PK->seed_pk);
+#elif defined(RSDPG)
+    expand_pk(EPK->V_tr,EPK->W_mat,PK->seed_pk);
+#endif
+    EPK->is_padd_key_ok = unpack_fp_syn(EPK->s,PK->s);
+    CROSS_STATS_PHASE_END(CROSS_PHASE_EXPAND_KEY);
 }
 
 /* verify returns 1 if signature is ok, 0 otherwise */
@@ -380,22 +517,31 @@ int CROSS_verify(const pk_t *const PK,
                  const char *const m,
                  const uint64_t mlen,
                  const CROSS_sig_t *const sig){
+    CROSS_pk_expanded_t EPK;
+    CROSS_pk_expand(PK,&EPK);
+    return CROSS_verify_expanded(&EPK,m,mlen,sig);
+}
+
+/* verifies the signature of the message of digest digest_msg, returns 1
+ * if signature is ok, 0 otherwise */
+static
+int verify_expanded_digest_msg(const CROSS_pk_expanded_t *const EPK,
+                               const uint8_t digest_msg[HASH_DIGEST_LENGTH],
+                               const CROSS_sig_t *const sig){
     CSPRNG_STATE_T csprng_state;
 
-    FP_ELEM V_tr[K][N-K];
-#if defined(RSDP)
-    expand_pk(V_tr,PK->seed_pk);
-#elif defined(RSDPG)
-    FZ_ELEM W_mat[M][N-M];
-    expand_pk(V_tr,W_mat,PK->seed_pk);
+    /* the expanded matrices are constant, ISO C11 forbids const in the
+     * arithmetic function prototypes */
+    FP_ELEM (*V_tr)[N-K] = (FP_ELEM (*)[N-K]) EPK->V_tr;
+#if defined(RSDPG)
+    FZ_ELEM (*W_mat)[N-M] = (FZ_ELEM (*)[N-M]) EPK->W_mat;
 #endif
+    const FP_ELEM *s = EPK->s;
+    uint8_t is_padd_key_ok = EPK->is_padd_key_ok;
 
-    FP_ELEM s[N-K];
-    uint8_t is_padd_key_ok;
-    is_padd_key_ok = unpack_fp_syn(s,PK->s);
-
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_CHALL_1);
     uint8_t digest_msg_cmt_salt[2*HASH_DIGEST_LENGTH+SALT_LENGTH_BYTES];
-    hash(digest_msg_cmt_salt, (uint8_t*) m, mlen, HASH_DOMAIN_SEP_CONST);
+    memcpy(digest_msg_cmt_salt, digest_msg, HASH_DIGEST_LENGTH);
     memcpy(digest_msg_cmt_salt+HASH_DIGEST_LENGTH, sig->digest_cmt, HASH_DIGEST_LENGTH);
     memcpy(digest_msg_cmt_salt+2*HASH_DIGEST_LENGTH, sig->salt, SALT_LENGTH_BYTES);
 
@@ -408,10 +554,14 @@ int CROSS_verify(const pk_t *const PK,
 
     FP_ELEM chall_1[T];
     csprng_fp_vec_chall_1(chall_1, &csprng_state);
+    CROSS_STATS_PHASE_END(CROSS_PHASE_CHALL_1);
 
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_CHALL_2);
     uint8_t chall_2[T]={0};
     expand_digest_to_fixed_weight(chall_2,sig->digest_chall_2);
+    CROSS_STATS_PHASE_END(CROSS_PHASE_CHALL_2);
 
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_SEED_TREE);
     uint8_t is_stree_padding_ok = 0;
 #if defined(NO_TREES)
     uint8_t round_seeds[T*SEED_LENGTH_BYTES] = {0};
@@ -423,6 +573,7 @@ int CROSS_verify(const pk_t *const PK,
     unsigned char round_seeds[T*SEED_LENGTH_BYTES] = {0};
     seed_leaves(round_seeds, seed_tree);
 #endif
+    CROSS_STATS_PHASE_END(CROSS_PHASE_SEED_TREE);
 
 #if defined(RSDP)
     uint8_t cmt_0_i_input[DENSELY_PACKED_FP_SYN_SIZE+
@@ -457,6 +608,7 @@ int CROSS_verify(const pk_t *const PK,
     int used_rsps = 0;
     int is_signature_ok = 1;
     uint8_t is_packed_padd_ok = 1;
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_ROUNDS);
     for(uint16_t i = 0; i< T; i++){
 
         uint16_t domain_sep_csprng = CSPRNG_DOMAIN_SEP_CONST + i + (2*T-1);
@@ -542,11 +694,13 @@ int CROSS_verify(const pk_t *const PK,
             hash(cmt_0[i], cmt_0_i_input, sizeof(cmt_0_i_input), domain_sep_hash);
         }
     } /* end for iterating on ZKID iterations */
+    CROSS_STATS_PHASE_END(CROSS_PHASE_ROUNDS);
 
     #ifndef SKIP_ASSERT
     assert(is_signature_ok);
     #endif
 
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_MERKLE_ROOT);
     uint8_t digest_cmt0_cmt1[2*HASH_DIGEST_LENGTH];
 
     uint8_t is_mtree_padding_ok = recompute_root(digest_cmt0_cmt1,
@@ -557,16 +711,22 @@ int CROSS_verify(const pk_t *const PK,
 
     uint8_t digest_cmt_prime[HASH_DIGEST_LENGTH];
     hash(digest_cmt_prime, digest_cmt0_cmt1 ,sizeof(digest_cmt0_cmt1), HASH_DOMAIN_SEP_CONST);
+    CROSS_STATS_PHASE_END(CROSS_PHASE_MERKLE_ROOT);
 
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_Y_PACKING);
     uint8_t y_digest_chall_1[T*DENSELY_PACKED_FP_VEC_SIZE+HASH_DIGEST_LENGTH];
 
     for(int x = 0; x < T; x++){
         pack_fp_vec(y_digest_chall_1+(x*DENSELY_PACKED_FP_VEC_SIZE), y[x]);
     }
+    CROSS_STATS_PHASE_END(CROSS_PHASE_Y_PACKING);
+
+    CROSS_STATS_PHASE_BEGIN(CROSS_PHASE_CHALL_2);
     memcpy(y_digest_chall_1+T*DENSELY_PACKED_FP_VEC_SIZE, digest_chall_1, HASH_DIGEST_LENGTH);
 
     uint8_t digest_chall_2_prime[HASH_DIGEST_LENGTH];
     hash(digest_chall_2_prime, y_digest_chall_1, sizeof(y_digest_chall_1), HASH_DOMAIN_SEP_CONST);
+    CROSS_STATS_PHASE_END(CROSS_PHASE_CHALL_2);
 
 
     int does_digest_cmt_match = ( memcmp(digest_cmt_prime,
@@ -593,3 +753,86 @@ int CROSS_verify(const pk_t *const PK,
                       is_packed_padd_ok;
     return is_signature_ok;
 }
+
+/* verify returns 1 if signature is ok, 0 otherwise */
+int CROSS_verify_expanded(const CROSS_pk_expanded_t *const EPK,
+                          const char *const m,
+                          const uint64_t mlen,
+                          const CROSS_sig_t *const sig){
+    uint8_t digest_msg[HASH_DIGEST_LENGTH];
+    hash(digest_msg, (uint8_t*) m, mlen, HASH_DOMAIN_SEP_CONST);
+    return verify_expanded_digest_msg(EPK,digest_msg,sig);
+}
+
+/* the reference implementation runs single threaded */
+int CROSS_verify_expanded_threaded(const CROSS_pk_expanded_t *const EPK,
+                                   const char *const m,
+                                   const uint64_t mlen,
+                                   const CROSS_sig_t *const sig,
+                                   const CROSS_executor_t *const exec){
+    (void) exec;
+    return CROSS_verify_expanded(EPK,m,mlen,sig);
+}
+
+/* verifies n signatures against the same public key: results[i] is 1 if
+ * sig[i] is ok, 0 otherwise. Returns 1 if all signatures are ok */
+int CROSS_verify_batch(const pk_t *const PK,
+                       const size_t n,
+                       const char *const m[],
+                       const uint64_t mlen[],
+                       const CROSS_sig_t *const sig[],
+                       int results[]){
+    /* the public key is expanded once for the whole batch */
+    CROSS_pk_expanded_t EPK;
+    CROSS_pk_expand(PK,&EPK);
+    int are_signatures_ok = 1;
+    for(size_t i = 0; i < n; i++){
+        results[i] = CROSS_verify_expanded(&EPK,m[i],mlen[i],sig[i]);
+        are_signatures_ok = are_signatures_ok && results[i];
+    }
+    return are_signatures_ok;
+}
+
+void CROSS_sign_init(CROSS_sign_ctx_t *const ctx){
+    hash_init(&ctx->msg_state);
+}
+
+void CROSS_sign_update(CROSS_sign_ctx_t *const ctx,
+                       const char *const m,
+                       const uint64_t mlen){
+    hash_update(&ctx->msg_state, (const uint8_t*) m, mlen);
+}
+
+/* sign cannot fail */
+void CROSS_sign_final(CROSS_sign_ctx_t *const ctx,
+                      const sk_t *const SK,
+                      CROSS_sig_t *const sig){
+    uint8_t digest_msg[HASH_DIGEST_LENGTH];
+    hash_final(digest_msg, &ctx->msg_state, HASH_DOMAIN_SEP_CONST);
+    CROSS_sk_expanded_t ESK;
+    CROSS_sk_expand(SK,&ESK);
+    CROSS_sign_scratch_t ws;
+    sign_expanded_digest_msg(&ESK,digest_msg,sig,&ws);
+    CROSS_sk_expanded_zeroize(&ESK);
+}
+
+void CROSS_verify_init(CROSS_verify_ctx_t *const ctx){
+    hash_init(&ctx->msg_state);
+}
+
+void CROSS_verify_update(CROSS_verify_ctx_t *const ctx,
+                         const char *const m,
+                         const uint64_t mlen){
+    hash_update(&ctx->msg_state, (const uint8_t*) m, mlen);
+}
+
+/* verify returns 1 if signature is ok, 0 otherwise */
+int CROSS_verify_final(CROSS_verify_ctx_t *const ctx,
+                       const pk_t *const PK,
+                       const CROSS_sig_t *const sig){
+    uint8_t digest_msg[HASH_DIGEST_LENGTH];
+    hash_final(digest_msg, &ctx->msg_state, HASH_DOMAIN_SEP_CONST);
+    CROSS_pk_expanded_t EPK;
+    CROSS_pk_expand(PK,&EPK);
+    return verify_expanded_digest_msg(&EPK,digest_msg,sig);
+}
@@ -32,6 +32,7 @@
 #include <string.h>
 
 #include "csprng_hash.h"
+#include "CROSS_stats.h"
 
 #define  POSITION_MASK (( (uint16_t)1 << BITS_TO_REPRESENT(T-1))-1)
 
@@ -91,3 +92,24 @@ void expand_digest_to_fixed_weight(uint8_t fixed_weight_string[T],
         bits_in_sub_buf -= bits_for_pos;      
     }  
 } /* expand_digest_to_fixed_weight */
+
+#if defined(CROSS_STATS)
+CROSS_stats_t CROSS_stats;
+uint64_t CROSS_stats_phase_begin[CROSS_NUM_PHASES];
+#endif
+
+void CROSS_stats_reset(void){
+#if defined(CROSS_STATS)
+    memset(&CROSS_stats,0,sizeof(CROSS_stats_t));
+#endif
+}
+
+/* copies the counts accumulated since the last reset, all zero when the
+ * instrumentation is not compiled in */
+void CROSS_stats_get(CROSS_stats_t *const stats){
+#if defined(CROSS_STATS)
+    memcpy(stats,&CROSS_stats,sizeof(CROSS_stats_t));
+#else
+    memset(stats,0,sizeof(CROSS_stats_t));
+#endif
+}
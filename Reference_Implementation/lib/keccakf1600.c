@@ -91,6 +91,8 @@ void KeccakF1600_StatePermute(uint64_t *state)
 {
    int round;
 
+   COUNT_KECCAK_PERMUTATION(1);
+
    uint64_t Aba, Abe, Abi, Abo, Abu;
    uint64_t Aga, Age, Agi, Ago, Agu;
    uint64_t Aka, Ake, Aki, Ako, Aku;
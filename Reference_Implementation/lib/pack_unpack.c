@@ -36,6 +36,12 @@
 
 /*Implementation of packing and unpacking of 3/7/9 bit elements into byte vectors*/
 
+/* The arithmetic may represent zero as 7 resp. 127 in Z_7 and F_127/Z_127:
+ * the packing of such elements normalizes it, so that the vectors need not be
+ * normalized beforehand */
+#define DZ_NORM_3_BIT(x) ((uint8_t)(((x) + (((x) + 1) >> 3)) & 0x07))
+#define DZ_NORM_7_BIT(x) ((uint8_t)(((x) + (((x) + 1) >> 7)) & 0x7F))
+
 /*
  * generic_pack_3_bit()
  *
@@ -288,7 +294,13 @@ void generic_pack_fp(uint8_t *out, const FP_ELEM *in,
                 const size_t outlen, const size_t inlen)
 {
 #if P == 127
-  generic_pack_7_bit(out, in, outlen, inlen);
+  /* the normalized copy is also free of aliasing with out */
+  uint8_t in_norm[N];
+  for(size_t i = 0; i < inlen; i++)
+  {
+    in_norm[i] = DZ_NORM_7_BIT(in[i]);
+  }
+  generic_pack_7_bit(out, in_norm, outlen, inlen);
 
 #elif P == 509
   generic_pack_9_bit(out, in, outlen, inlen);
@@ -312,11 +324,21 @@ void generic_pack_fp(uint8_t *out, const FP_ELEM *in,
 static inline
 void generic_pack_fz(uint8_t *out, const FZ_ELEM *in, const size_t outlen, const size_t inlen)
 {
+  /* the normalized copy is also free of aliasing with out */
+  uint8_t in_norm[N];
 #if Z == 127
-  generic_pack_7_bit(out, in, outlen, inlen);
+  for(size_t i = 0; i < inlen; i++)
+  {
+    in_norm[i] = DZ_NORM_7_BIT(in[i]);
+  }
+  generic_pack_7_bit(out, in_norm, outlen, inlen);
 
 #elif Z == 7
-  generic_pack_3_bit(out, in, outlen, inlen);
+  for(size_t i = 0; i < inlen; i++)
+  {
+    in_norm[i] = DZ_NORM_3_BIT(in[i]);
+  }
+  generic_pack_3_bit(out, in_norm, outlen, inlen);
 
 #else
   #error not implemented
@@ -46,55 +46,119 @@ int crypto_sign_keypair(unsigned char *pk,
    return 0; // NIST convention: 0 == zero errors
 } // end crypto_sign_keypair
 
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*... generating a detached signature sig[0],sig[1],...,sig[*siglen-1]        */
+/*... of message m[0],m[1],...,m[mlen-1]                                      */
+/*... under secret key sk[0],sk[1],...                                        */
+int crypto_sign_signature(unsigned char *sig,                   // out parameter
+                          unsigned long long *siglen,           // out parameter
+                          const unsigned char *m,               // in parameter
+                          unsigned long long mlen,              // in parameter
+                          const unsigned char *sk)              // in parameter
+{
+   /* sign cannot fail */
+   CROSS_sign((const sk_t *) sk,                            // in parameter
+             (const char *const) m,                             // in parameter
+             (const uint64_t) mlen,                             // in parameter
+             (CROSS_sig_t *) sig);                              // out parameter
+   *siglen = (unsigned long long) sizeof(CROSS_sig_t);
+
+   return 0;  // NIST convention: 0 == zero errors
+} // end crypto_sign_signature
+
 /*----------------------------------------------------------------------------*/
 /*                                                                            */
 /*... generating a signed message sm[0],sm[1],...,sm[*smlen-1]                */
 /*... from original message m[0],m[1],...,m[mlen-1]                           */
 /*... under secret key sk[0],sk[1],...                                        */
+/*... m may coincide with sm, in which case the message is not copied         */
 int crypto_sign(unsigned char *sm,                              // out parameter
                 unsigned long long *smlen,                      // out parameter
                 const unsigned char *m,                         // in parameter
                 unsigned long long mlen,                        // in parameter
                 const unsigned char *sk)                        // in parameter
 {
-   /* sign cannot fail */
-   memcpy(sm, m, mlen);
-   CROSS_sign((const sk_t *) sk,                            // in parameter
-             (const char *const) m,                             // in parameter
-             (const uint64_t) mlen,                             // in parameter
-             (CROSS_sig_t *) (sm+mlen));                        // out parameter
-   *smlen = mlen + (unsigned long long) sizeof(CROSS_sig_t);
+   if (sm != m) {
+      memmove(sm, m, (size_t) mlen);
+   }
+   unsigned long long siglen;
+   /* sign cannot fail, the message is read from sm as m may overlap it */
+   crypto_sign_signature(sm+mlen, &siglen, sm, mlen, sk);
+   *smlen = mlen + siglen;
 
    return 0;  // NIST convention: 0 == zero errors
 } // end crypto_sign
 
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*.  ... verifying a detached signature sig[0],sig[1],...,sig[siglen-1]       */
+/*.  ... of message m[0],m[1],...,m[mlen-1]                                   */
+/*.  ... under public key pk[0],pk[1],...                                     */
+int crypto_sign_verify(const unsigned char *sig,                // in parameter
+                       unsigned long long siglen,               // in parameter
+                       const unsigned char *m,                  // in parameter
+                       unsigned long long mlen,                 // in parameter
+                       const unsigned char *pk)                 // in parameter
+{
+   if (siglen != (unsigned long long) sizeof(CROSS_sig_t)) {
+      return -1;
+   }
+
+   /* verify returns 1 if signature is ok, 0 otherwise */
+   int ok = CROSS_verify((const pk_t *const) pk,            // in parameter
+                        (const char *const) m,                  // in parameter
+                        (const uint64_t) mlen,                  // in parameter
+                        (const CROSS_sig_t * const) sig);       // in parameter
+
+   return ok-1; // NIST convention: 0 == zero errors, -1 == error condition
+} // end crypto_sign_verify
+
 /*----------------------------------------------------------------------------*/
 /*                                                                            */
 /*.  ... verifying a signed message sm[0],sm[1],...,sm[smlen-1]               */
 /*.  ... under public key pk[0],pk[1],...                                     */
-/*.  ... and producing original message m[0],m[1],...,m[*mlen-1]              */
-int crypto_sign_open(unsigned char *m,                          // out parameter
-                     unsigned long long *mlen,                  // out parameter
-                     const unsigned char *sm,                   // in parameter
-                     unsigned long long smlen,                  // in parameter
-                     const unsigned char *pk)                   // in parameter
+/*.  ... and pointing *m to the original message within sm, of length *mlen   */
+int crypto_sign_open_inplace(const unsigned char **m,          // out parameter
+                             unsigned long long *mlen,          // out parameter
+                             const unsigned char *sm,           // in parameter
+                             unsigned long long smlen,          // in parameter
+                             const unsigned char *pk)           // in parameter
 {
 
    if (smlen < (size_t) sizeof(CROSS_sig_t)) {
       return -1;
    }
 
-   /* verify returns 1 if signature is ok, 0 otherwise */
    *mlen = smlen-(unsigned long long) sizeof(CROSS_sig_t);
-   
-   memcpy((unsigned char *) m, (const unsigned char *) sm, (size_t) *mlen);
-   int ok = CROSS_verify((const pk_t *const) pk,            // in parameter
-                        (const char *const) m,                  // in parameter
-                        (const uint64_t) *mlen,                 // in parameter
-                        (const CROSS_sig_t * const) (sm+*mlen));// in parameter
+   *m = sm;
 
+   return crypto_sign_verify(sm+*mlen,
+                             (unsigned long long) sizeof(CROSS_sig_t),
+                             sm,
+                             *mlen,
+                             pk);
+} // end crypto_sign_open_inplace
 
-   return ok-1; // NIST convention: 0 == zero errors, -1 == error condition
+/*----------------------------------------------------------------------------*/
+/*                                                                            */
+/*.  ... verifying a signed message sm[0],sm[1],...,sm[smlen-1]               */
+/*.  ... under public key pk[0],pk[1],...                                     */
+/*.  ... and producing original message m[0],m[1],...,m[*mlen-1]              */
+/*.  ... the message is copied out of sm only if the signature is valid       */
+int crypto_sign_open(unsigned char *m,                          // out parameter
+                     unsigned long long *mlen,                  // out parameter
+                     const unsigned char *sm,                   // in parameter
+                     unsigned long long smlen,                  // in parameter
+                     const unsigned char *pk)                   // in parameter
+{
+   const unsigned char *m_in_sm;
+   int outcome = crypto_sign_open_inplace(&m_in_sm, mlen, sm, smlen, pk);
+   if (outcome == 0 && m != m_in_sm) {
+      memmove(m, m_in_sm, (size_t) *mlen);
+   }
+
+   return outcome; // NIST convention: 0 == zero errors, -1 == error condition
 } // end crypto_sign_open
 
 /*----------------------------------------------------------------------------*/